@@ -0,0 +1,266 @@
+#include "long_arithmetic/bigInteger.h"
+#include "long_arithmetic/lazyRational.h"
+#include "long_arithmetic/rational.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+
+namespace {
+
+// the quadratic operations stop at smaller sizes, at 10^7 digits they
+// would run for hours per iteration
+constexpr std::int64_t kLinearLimit{10'000'000};
+constexpr std::int64_t kMultiplyLimit{100'000};
+constexpr std::int64_t kDivideLimit{10'000};
+constexpr std::int64_t kGcdLimit{1'000};
+constexpr std::int64_t kSumLimit{10'000};
+constexpr std::int64_t kDistinctSumLimit{1'000};
+
+std::string randomDigits(std::size_t count, std::uint32_t seed) {
+  std::mt19937 gen{seed};
+  std::uniform_int_distribution<int> digit{0, 9};
+  std::string res(count, '0');
+  for (auto&& item : res) {
+    item = static_cast<char>('0' + digit(gen));
+  }
+
+  res.front() = static_cast<char>('1' + digit(gen) % 9);
+  return res;
+}
+
+BigInteger randomNumber(std::size_t count, std::uint32_t seed) {
+  return BigInteger{randomDigits(count, seed)};
+}
+
+Rational randomRational(std::size_t count, std::uint32_t seed) {
+  return Rational{randomNumber(count, seed), randomNumber(count, seed + 1)};
+}
+
+// 80 digit numerators prime to 7 over the common denominator 7^100
+std::vector<Rational> commonDenominatorTerms(std::size_t count) {
+  BigInteger denom{1};
+  for (int i = 0; i != 100; ++i) {
+    denom *= 7;
+  }
+
+  std::vector<Rational> res{};
+  for (std::size_t i = 0; i != count; ++i) {
+    auto num = randomNumber(80, static_cast<std::uint32_t>(i)) * 7 + 1;
+    res.emplace_back(num, denom);
+  }
+
+  return res;
+}
+
+// 1 / (7919 k + 13), the denominators share few factors
+std::vector<Rational> distinctDenominatorTerms(std::size_t count) {
+  std::vector<Rational> res{};
+  for (std::size_t i = 1; i <= count; ++i) {
+    res.emplace_back(BigInteger{1},
+                     BigInteger{7919 * static_cast<long long>(i) + 13});
+  }
+
+  return res;
+}
+
+std::size_t digits(const benchmark::State& state) {
+  return static_cast<std::size_t>(state.range(0));
+}
+
+void BM_Add(benchmark::State& state) {
+  auto lhs = randomNumber(digits(state), 1);
+  auto rhs = randomNumber(digits(state), 2);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(lhs + rhs);
+  }
+
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_Subtract(benchmark::State& state) {
+  auto lhs = randomNumber(digits(state), 1);
+  auto rhs = randomNumber(digits(state), 2);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(lhs - rhs);
+  }
+
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_Multiply(benchmark::State& state) {
+  auto lhs = randomNumber(digits(state), 1);
+  auto rhs = randomNumber(digits(state), 2);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(lhs * rhs);
+  }
+
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_Divide(benchmark::State& state) {
+  auto lhs = randomNumber(2 * digits(state), 1);
+  auto rhs = randomNumber(digits(state), 2);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(lhs / rhs);
+  }
+
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_Gcd(benchmark::State& state) {
+  auto lhs = randomNumber(digits(state), 1);
+  auto rhs = randomNumber(digits(state), 2);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(gcd(lhs, rhs));
+  }
+
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_ToString(benchmark::State& state) {
+  auto number = randomNumber(digits(state), 1);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(number.toString());
+  }
+
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_Parse(benchmark::State& state) {
+  auto text = randomDigits(digits(state), 1);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(BigInteger{text});
+  }
+
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_RationalAdd(benchmark::State& state) {
+  auto lhs = randomRational(digits(state), 1);
+  auto rhs = randomRational(digits(state), 3);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(lhs + rhs);
+  }
+
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_RationalMultiply(benchmark::State& state) {
+  auto lhs = randomRational(digits(state), 1);
+  auto rhs = randomRational(digits(state), 3);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(lhs * rhs);
+  }
+
+  state.SetComplexityN(state.range(0));
+}
+
+// the range is the number of terms, every Rational sum takes a gcd with
+// the whole denominator
+void BM_RationalCommonSum(benchmark::State& state) {
+  auto terms = commonDenominatorTerms(digits(state));
+  for (auto _ : state) {
+    Rational sum{};
+    for (auto&& item : terms) {
+      sum += item;
+    }
+
+    benchmark::DoNotOptimize(sum);
+  }
+
+  state.SetComplexityN(state.range(0));
+}
+
+// the workload LazyRational is meant for: the numerators are added
+// without any gcd and the sum is reduced once
+void BM_LazyRationalCommonSum(benchmark::State& state) {
+  auto terms = commonDenominatorTerms(digits(state));
+  std::vector<LazyRational> lazy_terms(std::begin(terms), std::end(terms));
+  for (auto _ : state) {
+    LazyRational sum{};
+    for (auto&& item : lazy_terms) {
+      sum += item;
+    }
+
+    benchmark::DoNotOptimize(sum.value());
+  }
+
+  state.SetComplexityN(state.range(0));
+}
+
+// the range is the number of terms, Rational takes a gcd of the
+// denominators for every term and LazyRational a few of the whole sum
+void BM_RationalDistinctSum(benchmark::State& state) {
+  auto terms = distinctDenominatorTerms(digits(state));
+  for (auto _ : state) {
+    Rational sum{};
+    for (auto&& item : terms) {
+      sum += item;
+    }
+
+    benchmark::DoNotOptimize(sum);
+  }
+
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_LazyRationalDistinctSum(benchmark::State& state) {
+  auto terms = distinctDenominatorTerms(digits(state));
+  std::vector<LazyRational> lazy_terms(std::begin(terms), std::end(terms));
+  for (auto _ : state) {
+    LazyRational sum{};
+    for (auto&& item : lazy_terms) {
+      sum += item;
+    }
+
+    benchmark::DoNotOptimize(sum.value());
+  }
+
+  state.SetComplexityN(state.range(0));
+}
+
+// the range is the number of digits after the point
+void BM_RationalAsDecimal(benchmark::State& state) {
+  auto value = randomRational(20, 1);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(value.asDecimal(digits(state)));
+  }
+
+  state.SetComplexityN(state.range(0));
+}
+
+} // namespace
+
+BENCHMARK(BM_Add)->RangeMultiplier(10)->Range(1, kLinearLimit)->Complexity();
+BENCHMARK(BM_Subtract)
+    ->RangeMultiplier(10)->Range(1, kLinearLimit)->Complexity();
+BENCHMARK(BM_Multiply)
+    ->RangeMultiplier(10)->Range(1, kMultiplyLimit)->Complexity();
+BENCHMARK(BM_Divide)
+    ->RangeMultiplier(10)->Range(1, kDivideLimit)->Complexity();
+BENCHMARK(BM_Gcd)->RangeMultiplier(10)->Range(1, kGcdLimit)->Complexity();
+BENCHMARK(BM_ToString)
+    ->RangeMultiplier(10)->Range(1, kLinearLimit)->Complexity();
+BENCHMARK(BM_Parse)->RangeMultiplier(10)->Range(1, kLinearLimit)->Complexity();
+BENCHMARK(BM_RationalAdd)
+    ->RangeMultiplier(10)->Range(1, kGcdLimit)->Complexity();
+BENCHMARK(BM_RationalMultiply)
+    ->RangeMultiplier(10)->Range(1, kGcdLimit)->Complexity();
+BENCHMARK(BM_RationalCommonSum)
+    ->RangeMultiplier(10)->Range(10, kSumLimit)->Complexity();
+BENCHMARK(BM_LazyRationalCommonSum)
+    ->RangeMultiplier(10)->Range(10, kSumLimit)->Complexity();
+BENCHMARK(BM_RationalDistinctSum)
+    ->RangeMultiplier(10)->Range(10, kDistinctSumLimit)->Complexity();
+BENCHMARK(BM_LazyRationalDistinctSum)
+    ->RangeMultiplier(10)->Range(10, kDistinctSumLimit)->Complexity();
+BENCHMARK(BM_RationalAsDecimal)
+    ->RangeMultiplier(10)->Range(1, kDivideLimit)->Complexity();
+
+BENCHMARK_MAIN();
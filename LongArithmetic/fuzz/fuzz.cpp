@@ -0,0 +1,370 @@
+#include "long_arithmetic/bigInteger.h"
+#include "long_arithmetic/bigIntegerAccumulator.h"
+#include "long_arithmetic/bigIntegerView.h"
+#include "long_arithmetic/rational.h"
+#include "long_arithmetic/serialization.h"
+#include "long_arithmetic/summation.h"
+#include "long_arithmetic/tuning.h"
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+// every input is decoded into an operation and its operands, the fast
+// paths of the library are checked against slow references: schoolbook
+// multiplication, long long arithmetic for short operands and algebraic
+// identities for everything else
+
+namespace {
+
+// Euclid and the Rational reductions are cubic in the operand length, so
+// their operands stay shorter
+constexpr std::size_t kMaxLimbs{200};
+constexpr std::size_t kMaxGcdLimbs{40};
+// a product of two such numbers still fits into long long
+constexpr std::size_t kMaxWordLimbs{9};
+
+void check(bool condition, const std::string& what) {
+  if (!condition)
+    throw std::runtime_error(what);
+}
+
+std::string describe(const BigInteger& lhs, const BigInteger& rhs) {
+  return " for " + lhs.toString() + " and " + rhs.toString();
+}
+
+// reads the input byte by byte, zeros once it is exhausted
+class FuzzInput {
+private:
+  const std::uint8_t* data_;
+  std::size_t size_;
+  std::size_t pos_{0};
+
+public:
+  FuzzInput(const std::uint8_t* data, std::size_t size)
+      : data_{data}, size_{size} {
+  }
+
+  std::uint8_t byte() {
+    return pos_ < size_ ? data_[pos_++] : 0;
+  }
+
+  // random digits, all nines or a power of ten, so carries and borrows
+  // run through the whole number
+  BigInteger number(std::size_t max_limbs) {
+    auto pattern = byte();
+    std::size_t count = byte();
+    count = (count << 8 | byte()) % (max_limbs + 1);
+    if (pattern % 4 == 0)
+      count %= kMaxWordLimbs + 1;
+
+    std::string digits(count, '0');
+    for (auto&& item : digits) {
+      if (pattern % 4 == 1)
+        item = '9';
+      else if (pattern % 4 != 3)
+        item = static_cast<char>('0' + byte() % 10);
+    }
+
+    if (pattern % 4 == 3 && count)
+      digits.front() = '1';
+
+    if (digits.empty())
+      digits = "0";
+
+    if (pattern & 0x80)
+      digits.insert(digits.begin(), '-');
+
+    return BigInteger{digits};
+  }
+
+  Rational rational(std::size_t max_limbs) {
+    auto num = number(max_limbs);
+    auto denom = abs(number(max_limbs));
+    return denom ? Rational{num, denom} : Rational{num};
+  }
+};
+
+bool isWord(const BigInteger& value) {
+  return value.limbCount() <= kMaxWordLimbs;
+}
+
+long long toWord(const BigInteger& value) {
+  return std::stoll(value.toString());
+}
+
+// the value and its text round trip agree only when the limbs are
+// normalized
+void checkCanonical(const BigInteger& value, const std::string& what) {
+  auto text = value.toString();
+  auto digits = text.size() - (text.front() == '-' ? 1 : 0);
+  check(value == BigInteger{text} &&
+            (value ? value.limbCount() == digits : value.limbCount() == 0),
+        what + " is not normalized: " + text);
+}
+
+void checkCanonical(const Rational& value, const std::string& what) {
+  auto num = value.numerator();
+  auto denom = value.denominator();
+  checkCanonical(num, what);
+  checkCanonical(denom, what);
+  check(denom > 0 && gcd(num, denom) == 1,
+        what + " is not reduced: " + value.toString());
+}
+
+void checkMultiply(FuzzInput& input) {
+  auto lhs = input.number(kMaxLimbs);
+  auto rhs = input.number(kMaxLimbs);
+  auto saved = thresholds();
+
+  setThresholds({lhs.limbCount() + rhs.limbCount() + 1});
+  auto schoolbook = lhs * rhs;
+  setThresholds({2});
+  auto karatsuba = lhs * rhs;
+  setThresholds(saved);
+
+  check(karatsuba == schoolbook, "karatsuba product" + describe(lhs, rhs));
+  checkCanonical(karatsuba, "product");
+  check(lhs * rhs == rhs * lhs, "commuted product" + describe(lhs, rhs));
+  if (isWord(lhs) && isWord(rhs)) {
+    check(schoolbook == BigInteger{toWord(lhs) * toWord(rhs)},
+          "product" + describe(lhs, rhs));
+  }
+}
+
+void checkDivide(FuzzInput& input) {
+  auto lhs = input.number(kMaxLimbs);
+  auto rhs = input.number(kMaxLimbs / 2);
+  if (!rhs)
+    return;
+
+  auto quotient = lhs / rhs;
+  auto remainder = lhs % rhs;
+  checkCanonical(quotient, "quotient");
+  checkCanonical(remainder, "remainder");
+  check(quotient * rhs + remainder == lhs,
+        "quotient and remainder" + describe(lhs, rhs));
+  check(abs(remainder) < abs(rhs), "remainder size" + describe(lhs, rhs));
+  check(!remainder || (remainder < 0) == (lhs < 0),
+        "remainder sign" + describe(lhs, rhs));
+  if (isWord(lhs) && isWord(rhs)) {
+    check(quotient == BigInteger{toWord(lhs) / toWord(rhs)},
+          "quotient" + describe(lhs, rhs));
+    check(remainder == BigInteger{toWord(lhs) % toWord(rhs)},
+          "remainder" + describe(lhs, rhs));
+  }
+}
+
+void checkAdd(FuzzInput& input) {
+  auto lhs = input.number(kMaxLimbs);
+  auto rhs = input.number(kMaxLimbs);
+  auto sum = lhs + rhs;
+  auto difference = lhs - rhs;
+  checkCanonical(sum, "sum");
+  checkCanonical(difference, "difference");
+  check(sum - rhs == lhs && difference + rhs == lhs,
+        "sum and difference" + describe(lhs, rhs));
+  check(difference == -(rhs - lhs), "negated difference" + describe(lhs, rhs));
+  if (isWord(lhs) && isWord(rhs)) {
+    check(sum == BigInteger{toWord(lhs) + toWord(rhs)},
+          "sum" + describe(lhs, rhs));
+    check(difference == BigInteger{toWord(lhs) - toWord(rhs)},
+          "difference" + describe(lhs, rhs));
+  }
+}
+
+void checkCompare(FuzzInput& input) {
+  auto lhs = input.number(kMaxLimbs);
+  auto rhs = input.byte() % 2 ? lhs + input.number(2) : input.number(kMaxLimbs);
+  auto difference = lhs - rhs;
+  auto expected = difference ? (difference < 0 ? -1 : 1) : 0;
+  auto order = lhs <=> rhs;
+  check((order < 0 ? -1 : order > 0 ? 1 : 0) == expected,
+        "ordering" + describe(lhs, rhs));
+  check((lhs < rhs) == (expected < 0) && (lhs == rhs) == (expected == 0),
+        "comparison" + describe(lhs, rhs));
+  check((lhs == rhs) == (lhs.toString() == rhs.toString()) &&
+            (lhs != rhs || lhs.hash() == rhs.hash()),
+        "equality" + describe(lhs, rhs));
+}
+
+void checkGcd(FuzzInput& input) {
+  auto factor = input.number(kMaxGcdLimbs / 2);
+  auto lhs = input.number(kMaxGcdLimbs / 2) * factor;
+  auto rhs = input.number(kMaxGcdLimbs / 2) * factor;
+  auto divisor = gcd(lhs, rhs);
+  checkCanonical(divisor, "gcd");
+  check(divisor >= 0 && (divisor || (!lhs && !rhs)),
+        "gcd sign" + describe(lhs, rhs));
+  if (!divisor)
+    return;
+
+  check(!(lhs % divisor) && !(rhs % divisor) &&
+            gcd(lhs / divisor, rhs / divisor) == 1,
+        "gcd" + describe(lhs, rhs));
+}
+
+// the operators taking a BigIntegerView go their own way through the
+// limbs of the view
+void checkView(FuzzInput& input) {
+  auto lhs = input.number(kMaxLimbs);
+  auto rhs = input.number(kMaxLimbs / 2);
+  // the packed digits follow the sign byte and the 8 byte count
+  std::ostringstream out{};
+  BinaryWriter{out}.write(rhs);
+  auto bytes = out.str();
+  PackedDigits limbs{reinterpret_cast<const unsigned char*>(bytes.data()) + 9,
+                     rhs.limbCount()};
+
+  BigIntegerView view{rhs.sign(), limbs};
+  check(view.toBigInteger() == rhs && view == rhs,
+        "view" + describe(lhs, rhs));
+  check(lhs + view == lhs + rhs && lhs - view == lhs - rhs &&
+            lhs * view == lhs * rhs,
+        "view arithmetic" + describe(lhs, rhs));
+  check((view.compare(lhs) < 0) == (rhs < lhs) && view.hash() == rhs.hash(),
+        "view comparison" + describe(lhs, rhs));
+  check((lhs < view) == (lhs < rhs) && (lhs <= view) == (lhs <= rhs) &&
+            (lhs > view) == (lhs > rhs) && (lhs >= view) == (lhs >= rhs) &&
+            (lhs == view) == (lhs == rhs) && (lhs != view) == (lhs != rhs),
+        "mirrored view comparison" + describe(lhs, rhs));
+  if (rhs) {
+    check(lhs / view == lhs / rhs && lhs % view == lhs % rhs,
+          "view division" + describe(lhs, rhs));
+  }
+}
+
+void checkAccumulator(FuzzInput& input) {
+  BigIntegerAccumulator accumulator{};
+  BigInteger expected{};
+  std::vector<BigInteger> terms{};
+  for (auto count = input.byte() % 16; count--;) {
+    auto term = input.number(kMaxLimbs / 4);
+    if (input.byte() % 2) {
+      accumulator -= term;
+      expected -= term;
+      terms.push_back(-term);
+    } else {
+      accumulator += term;
+      expected += term;
+      terms.push_back(term);
+    }
+  }
+
+  auto value = accumulator.value();
+  checkCanonical(value, "accumulated sum");
+  check(value == expected, "accumulated sum " + value.toString());
+  check(sum(terms, 2) == expected, "parallel sum " + expected.toString());
+}
+
+void checkRational(FuzzInput& input) {
+  auto lhs = input.rational(input.byte() % 2 ? kMaxWordLimbs : kMaxGcdLimbs);
+  auto rhs = input.rational(input.byte() % 2 ? kMaxWordLimbs : kMaxGcdLimbs);
+  auto what = " for " + lhs.toString() + " and " + rhs.toString();
+  auto a = lhs.numerator(), b = lhs.denominator();
+  auto c = rhs.numerator(), d = rhs.denominator();
+
+  // the results are compared with the unreduced fractions
+  auto matches = [](const Rational& value, const BigInteger& num,
+                    const BigInteger& denom) {
+    return value.numerator() * denom == num * value.denominator();
+  };
+
+  auto sum = lhs + rhs;
+  auto difference = lhs - rhs;
+  auto product = lhs * rhs;
+  checkCanonical(sum, "rational sum");
+  checkCanonical(difference, "rational difference");
+  checkCanonical(product, "rational product");
+  check(matches(sum, a * d + c * b, b * d), "rational sum" + what);
+  check(matches(difference, a * d - c * b, b * d),
+        "rational difference" + what);
+  check(matches(product, a * c, b * d), "rational product" + what);
+  if (c) {
+    auto quotient = lhs / rhs;
+    checkCanonical(quotient, "rational quotient");
+    check(matches(quotient, c < 0 ? -a * d : a * d, abs(c) * b),
+          "rational quotient" + what);
+  }
+
+  auto expected = a * d <=> c * b;
+  auto order = lhs.compare(rhs);
+  check((order < 0) == (expected < 0) && (order == 0) == (expected == 0) &&
+            (lhs == rhs) == (expected == 0) && (lhs < rhs) == (expected < 0),
+        "rational comparison" + what);
+
+  auto text = lhs.toString();
+  Rational parsed{};
+  auto [ptr, ec] = fromChars(text.data(), text.data() + text.size(), parsed);
+  check(ec == std::errc{} && ptr == text.data() + text.size() &&
+            parsed == lhs,
+        "rational text " + text);
+}
+
+using Check = void (*)(FuzzInput&);
+constexpr Check kChecks[] = {
+    checkMultiply, checkDivide,  checkAdd,         checkCompare,
+    checkGcd,      checkView,    checkAccumulator, checkRational};
+
+void run(const std::uint8_t* data, std::size_t size) {
+  FuzzInput input{data, size};
+  auto selector = input.byte();
+  kChecks[selector % std::size(kChecks)](input);
+}
+
+} // namespace
+
+#ifdef LONG_ARITHMETIC_LIBFUZZER
+
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* data,
+                                      std::size_t size) {
+  try {
+    run(data, size);
+  } catch (const std::exception& error) {
+    std::cerr << error.what() << "\n";
+    std::abort();
+  }
+
+  return 0;
+}
+
+#else
+
+// usage: long_arithmetic_fuzz [iterations [seed]], runs the checks on
+// random inputs and stops at the first failure
+int main(int argc, char* argv[]) {
+  std::size_t iterations = argc > 1 ? std::stoul(argv[1]) : 1000;
+  std::uint32_t seed =
+      argc > 2 ? static_cast<std::uint32_t>(std::stoul(argv[2])) : 1;
+  std::mt19937 gen{seed};
+  std::uniform_int_distribution<int> byte{0, 255};
+  std::uniform_int_distribution<std::size_t> length{0, 4 * kMaxLimbs};
+
+  std::vector<std::uint8_t> data{};
+  for (std::size_t i = 0; i != iterations; ++i) {
+    data.resize(length(gen));
+    for (auto&& item : data) {
+      item = static_cast<std::uint8_t>(byte(gen));
+    }
+
+    try {
+      run(data.data(), data.size());
+    } catch (const std::exception& error) {
+      std::cerr << "iteration " << i << ": " << error.what() << "\n";
+      return 1;
+    }
+  }
+
+  std::cout << iterations << " inputs passed\n";
+}
+
+#endif
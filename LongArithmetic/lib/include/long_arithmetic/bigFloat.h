@@ -0,0 +1,78 @@
+#pragma once
+#ifndef BIGFLOAT_H_
+#define BIGFLOAT_H_
+
+#include "bigInteger.h"
+#include "rounding.h"
+
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+
+// decimal floating point number mantissa * 10^exponent: the mantissa keeps
+// at most precision significant digits and no trailing zeros. Compound
+// operations round to the precision and the rounding mode of the left-hand
+// operand
+class BigFloat {
+private:
+  BigInteger mantissa_{0};
+  std::int64_t exponent_{0};
+  std::size_t precision_{kDefaultPrecision};
+  RoundingMode rounding_{RoundingMode::HalfEven};
+
+  static std::int64_t digitCount(const BigInteger& number);
+  static int dropDigits(BigInteger& number, std::int64_t count, bool& exact);
+  void normalize();
+
+  friend BigFloat sqrt(const BigFloat& number);
+
+public:
+  static constexpr std::size_t kDefaultPrecision{50};
+
+  BigFloat() = default;
+  BigFloat(const BigInteger& value,
+           std::size_t precision = kDefaultPrecision,
+           RoundingMode rounding = RoundingMode::HalfEven);
+  // accepts [-]digits[.digits][e[-]digits]
+  explicit BigFloat(const std::string& number_str,
+                    std::size_t precision = kDefaultPrecision,
+                    RoundingMode rounding = RoundingMode::HalfEven);
+
+  // mantissa * 10^exponent rounded to the precision
+  static BigFloat fromParts(const BigInteger& mantissa, std::int64_t exponent,
+                            std::size_t precision = kDefaultPrecision,
+                            RoundingMode rounding = RoundingMode::HalfEven);
+
+  const BigInteger& mantissa() const noexcept;
+  std::int64_t exponent() const noexcept;
+  std::size_t precision() const noexcept;
+  RoundingMode rounding() const noexcept;
+  void setPrecision(std::size_t precision);
+  void setRounding(RoundingMode rounding) noexcept;
+
+  BigFloat operator-() const;
+
+  BigFloat& operator+=(const BigFloat& rhs);
+  BigFloat& operator-=(const BigFloat& rhs);
+  BigFloat& operator*=(const BigFloat& rhs);
+  BigFloat& operator/=(const BigFloat& rhs);
+
+  std::string toString() const;
+  std::strong_ordering operator<=>(const BigFloat& rhs) const;
+};
+
+BigFloat operator+(const BigFloat& lhs, const BigFloat& rhs);
+BigFloat operator-(const BigFloat& lhs, const BigFloat& rhs);
+BigFloat operator*(const BigFloat& lhs, const BigFloat& rhs);
+BigFloat operator/(const BigFloat& lhs, const BigFloat& rhs);
+
+bool operator==(const BigFloat& lhs, const BigFloat& rhs);
+
+std::ostream& operator<<(std::ostream& out, const BigFloat& rhs);
+
+BigFloat sqrt(const BigFloat& number);
+
+#endif // BIGFLOAT_H_ //------------------------------------------------//
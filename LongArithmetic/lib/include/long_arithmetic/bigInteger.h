@@ -2,22 +2,42 @@
 #ifndef BIGINTEGER_H_
 #define BIGINTEGER_H_
 
+#include <compare>
+#include <cstddef>
+#include <functional>
 #include <iostream>
 #include <string>
 #include <vector>
 
 
+class BigIntegerView;
+
 class BigInteger {
 private:
   int sign_{1};
   std::vector<int> number_{};
 
+  friend class BigIntegerArray;
+  friend class BinaryReader;
+  friend class BinaryWriter;
+  friend class BigIntegerView;
+  friend class BigIntegerAccumulator;
+  friend class BigFloat;
+  friend class Rational;
+  friend BigInteger gcd(const BigInteger& lhs, const BigInteger& rhs);
+
+  // num / denom rounded to nearest, ties to even, for a positive denom
+  template <typename Float>
+  static Float ratioToFloat(const BigInteger& num, const BigInteger& denom);
+
 public:
   BigInteger() = default;
-  BigInteger(int number);
+  BigInteger(long long number);
   BigInteger(std::string number_str);
   BigInteger(const BigInteger&) = default;
+  BigInteger(BigInteger&&) noexcept = default;
   BigInteger& operator=(const BigInteger&) = default;
+  BigInteger& operator=(BigInteger&&) noexcept = default;
 
   BigInteger operator-() const;
   BigInteger& operator++();
@@ -31,12 +51,41 @@ public:
   BigInteger& operator/=(const BigInteger& rhs);
   BigInteger& operator%=(const BigInteger& rhs);
 
+  BigInteger& operator+=(const BigIntegerView& rhs);
+  BigInteger& operator-=(const BigIntegerView& rhs);
+  BigInteger& operator*=(const BigIntegerView& rhs);
+  BigInteger& operator/=(const BigIntegerView& rhs);
+  BigInteger& operator%=(const BigIntegerView& rhs);
+
+  // multiplies by 10^count
+  BigInteger& shiftLeft(std::size_t count);
+
   explicit operator bool() const;
 
   std::string toString() const;
+  // rounded to nearest, ties to even
+  double toDouble() const;
+  long double toLongDouble() const;
+  std::size_t limbCount() const noexcept;
+  // -1, 0 or 1
+  int sign() const noexcept;
+  bool isZero() const noexcept;
+  bool isOdd() const noexcept;
+  bool isOne() const noexcept;
+  // decimal digits of the absolute value, one for zero. It is exact while
+  // the limbs are decimal digits
+  std::size_t digitCountEstimate() const noexcept;
+  // for int, long, long long and their unsigned forms
+  template <typename Integer>
+  bool fits() const noexcept;
+  // throws when the value does not fit into Integer
+  template <typename Integer>
+  Integer to() const;
+  std::size_t hash() const noexcept;
   void swap(BigInteger& rhs);
   bool compare(const BigInteger& rhs) const;
   bool less(const BigInteger& rhs) const;
+  std::strong_ordering operator<=>(const BigInteger& rhs) const;
 };
 
 BigInteger operator+(const BigInteger& lhs, const BigInteger& rhs);
@@ -47,10 +96,6 @@ BigInteger operator%(const BigInteger& lhs, const BigInteger& rhs);
 
 bool operator==(const BigInteger& lhs, const BigInteger& rhs);
 bool operator!=(const BigInteger& lhs, const BigInteger& rhs);
-bool operator<(const BigInteger& lhs, const BigInteger& rhs);
-bool operator>(const BigInteger& lhs, const BigInteger& rhs);
-bool operator<=(const BigInteger& lhs, const BigInteger& rhs);
-bool operator>=(const BigInteger& lhs, const BigInteger& rhs);
 
 BigInteger operator""_bi(const char* str);
 
@@ -61,5 +106,14 @@ void swap(BigInteger& lhs, BigInteger& rhs);
 BigInteger abs(const BigInteger& number);
 BigInteger gcd(const BigInteger& lhs, const BigInteger& rhs);
 BigInteger lcm(const BigInteger& lhs, const BigInteger& rhs);
+BigInteger pow10(std::size_t exponent);
+BigInteger pow2(std::size_t exponent);
+
+template <>
+struct std::hash<BigInteger> {
+  std::size_t operator()(const BigInteger& value) const noexcept {
+    return value.hash();
+  }
+};
 
 #endif // BIGINTEGER_H_ //----------------------------------------------//
@@ -0,0 +1,37 @@
+#pragma once
+#ifndef BIGINTEGERACCUMULATOR_H_
+#define BIGINTEGERACCUMULATOR_H_
+
+#include "bigInteger.h"
+#include "bigIntegerView.h"
+
+#include <cstddef>
+#include <vector>
+
+
+// sums many numbers without carry propagation after every term: each limb
+// keeps the signed raw sum of its column, and the limbs are normalised
+// only when the value is read or when another term could overflow them
+class BigIntegerAccumulator {
+private:
+  std::vector<int> limbs_{};
+  std::size_t pending_{0};
+
+  template <typename Limbs>
+  void add(int sign, const Limbs& limbs);
+
+public:
+  BigIntegerAccumulator() = default;
+  explicit BigIntegerAccumulator(const BigInteger& value);
+
+  BigIntegerAccumulator& operator+=(const BigInteger& rhs);
+  BigIntegerAccumulator& operator-=(const BigInteger& rhs);
+  BigIntegerAccumulator& operator+=(const BigIntegerView& rhs);
+  BigIntegerAccumulator& operator-=(const BigIntegerView& rhs);
+
+  void normalize();
+  BigInteger value();
+  void clear() noexcept;
+};
+
+#endif // BIGINTEGERACCUMULATOR_H_ //-----------------------------------//
@@ -0,0 +1,49 @@
+#pragma once
+#ifndef BIGINTEGERARRAY_H_
+#define BIGINTEGERARRAY_H_
+
+#include "bigInteger.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+// struct-of-arrays container for many small numbers: every value is kept
+// in ten's complement with the common width, and the limbs of one position
+// are stored contiguously, so the batch kernels run over flat rows
+class BigIntegerArray {
+private:
+  std::size_t size_{0};
+  std::size_t capacity_{0};
+  std::size_t width_{1};
+  std::vector<std::int8_t> limbs_{};
+
+  std::int8_t* row(std::size_t pos);
+  const std::int8_t* row(std::size_t pos) const;
+  std::size_t headroom() const;
+  void relayout(std::size_t capacity, std::size_t width);
+  void ensureHeadroom(std::size_t count);
+
+public:
+  BigIntegerArray() = default;
+  explicit BigIntegerArray(const std::vector<BigInteger>& values);
+
+  std::size_t size() const noexcept;
+  [[nodiscard]] bool empty() const noexcept;
+  std::size_t width() const noexcept;
+
+  void reserve(std::size_t capacity);
+  void push_back(const BigInteger& value);
+  void set(std::size_t index, const BigInteger& value);
+  BigInteger operator[](std::size_t index) const;
+
+  BigIntegerArray& operator+=(const BigIntegerArray& rhs);
+  BigIntegerArray& operator*=(int scalar);
+
+  // -1, 0 or 1 for every pair of elements
+  std::vector<int> compare(const BigIntegerArray& rhs) const;
+  BigInteger sum() const;
+};
+
+#endif // BIGINTEGERARRAY_H_ //----------------------------------------//
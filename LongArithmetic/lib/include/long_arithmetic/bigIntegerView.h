@@ -0,0 +1,168 @@
+#pragma once
+#ifndef BIGINTEGERVIEW_H_
+#define BIGINTEGERVIEW_H_
+
+#include "bigInteger.h"
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <string>
+#include <vector>
+
+
+// decimal digits packed two per byte as in the binary layout of
+// serialization.h: digit i is the low nibble of byte i / 2 when i is even
+// and the high nibble otherwise
+class PackedDigits {
+private:
+  const unsigned char* data_{nullptr};
+  std::size_t size_{0};
+
+public:
+  class Iterator {
+  private:
+    const unsigned char* data_{nullptr};
+    std::size_t pos_{0};
+
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type        = unsigned char;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = const unsigned char*;
+    using reference         = unsigned char;
+
+    Iterator() = default;
+    Iterator(const unsigned char* data, std::size_t pos);
+
+    reference operator*() const noexcept;
+    Iterator& operator++() noexcept;
+    Iterator operator++(int) noexcept;
+    bool operator==(const Iterator& rhs) const noexcept;
+    bool operator!=(const Iterator& rhs) const noexcept;
+  };
+
+  PackedDigits() = default;
+  // size counts digits, data holds (size + 1) / 2 bytes
+  PackedDigits(const unsigned char* data, std::size_t size);
+
+  std::size_t size() const noexcept;
+  [[nodiscard]] bool empty() const noexcept;
+  unsigned char operator[](std::size_t pos) const noexcept;
+  Iterator begin() const noexcept;
+  Iterator end() const noexcept;
+};
+
+// inline, the arithmetic kernels read the digits one by one
+inline unsigned char PackedDigits::operator[](std::size_t pos) const noexcept {
+  return (data_[pos / 2] >> (4 * (pos % 2))) & 0x0f;
+}
+
+// read-only number over digits stored in the binary layout of
+// serialization.h, e.g. inside a memory mapped file; the digits are
+// neither copied nor owned
+class BigIntegerView {
+private:
+  int sign_{1};
+  PackedDigits limbs_{};
+
+public:
+  BigIntegerView() = default;
+  BigIntegerView(int sign, PackedDigits limbs);
+
+  // -1, 0 or 1
+  int sign() const noexcept;
+  PackedDigits limbs() const noexcept;
+
+  BigInteger toBigInteger() const;
+  std::string toString() const;
+  int compare(const BigIntegerView& rhs) const;
+  int compare(const BigInteger& rhs) const;
+  std::size_t hash() const noexcept;
+};
+
+bool operator==(const BigIntegerView& lhs, const BigIntegerView& rhs);
+bool operator!=(const BigIntegerView& lhs, const BigIntegerView& rhs);
+bool operator<(const BigIntegerView& lhs, const BigIntegerView& rhs);
+bool operator>(const BigIntegerView& lhs, const BigIntegerView& rhs);
+bool operator<=(const BigIntegerView& lhs, const BigIntegerView& rhs);
+bool operator>=(const BigIntegerView& lhs, const BigIntegerView& rhs);
+
+bool operator==(const BigIntegerView& lhs, const BigInteger& rhs);
+bool operator!=(const BigIntegerView& lhs, const BigInteger& rhs);
+bool operator<(const BigIntegerView& lhs, const BigInteger& rhs);
+bool operator>(const BigIntegerView& lhs, const BigInteger& rhs);
+bool operator<=(const BigIntegerView& lhs, const BigInteger& rhs);
+bool operator>=(const BigIntegerView& lhs, const BigInteger& rhs);
+
+bool operator==(const BigInteger& lhs, const BigIntegerView& rhs);
+bool operator!=(const BigInteger& lhs, const BigIntegerView& rhs);
+bool operator<(const BigInteger& lhs, const BigIntegerView& rhs);
+bool operator>(const BigInteger& lhs, const BigIntegerView& rhs);
+bool operator<=(const BigInteger& lhs, const BigIntegerView& rhs);
+bool operator>=(const BigInteger& lhs, const BigIntegerView& rhs);
+
+BigInteger operator+(const BigInteger& lhs, const BigIntegerView& rhs);
+BigInteger operator-(const BigInteger& lhs, const BigIntegerView& rhs);
+BigInteger operator*(const BigInteger& lhs, const BigIntegerView& rhs);
+BigInteger operator/(const BigInteger& lhs, const BigIntegerView& rhs);
+BigInteger operator%(const BigInteger& lhs, const BigIntegerView& rhs);
+
+std::ostream& operator<<(std::ostream& out, const BigIntegerView& rhs);
+
+template <>
+struct std::hash<BigIntegerView> {
+  std::size_t operator()(const BigIntegerView& value) const noexcept {
+    return value.hash();
+  }
+};
+
+// read-only mapping of a file written by BinaryWriter which contains
+// BigIntegers only; iteration yields views into the mapped memory. Every
+// record is validated as BinaryReader would when the iterator reaches it,
+// and a malformed one throws. Where mmap is not available the file is read
+// into a buffer instead
+class MappedBigIntegers {
+private:
+  const unsigned char* data_{nullptr};
+  std::size_t size_{0};
+  std::vector<unsigned char> buffer_{};
+
+public:
+  class Iterator {
+  private:
+    const unsigned char* pos_{nullptr};
+    const unsigned char* end_{nullptr};
+    const unsigned char* next_{nullptr};
+    BigIntegerView current_{};
+
+    void parse();
+
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type        = BigIntegerView;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = const BigIntegerView*;
+    using reference         = const BigIntegerView&;
+
+    Iterator() = default;
+    Iterator(const unsigned char* pos, const unsigned char* end);
+
+    reference operator*() const;
+    pointer operator->() const;
+    Iterator& operator++();
+    Iterator operator++(int);
+    bool operator==(const Iterator& rhs) const;
+    bool operator!=(const Iterator& rhs) const;
+  };
+
+  explicit MappedBigIntegers(const std::string& path);
+  MappedBigIntegers(const MappedBigIntegers&) = delete;
+  MappedBigIntegers& operator=(const MappedBigIntegers&) = delete;
+  ~MappedBigIntegers();
+
+  Iterator begin() const;
+  Iterator end() const;
+};
+
+#endif // BIGINTEGERVIEW_H_ //------------------------------------------//
@@ -0,0 +1,35 @@
+#pragma once
+#ifndef COMBINATORICS_H_
+#define COMBINATORICS_H_
+
+#include "bigInteger.h"
+
+#include <cstdint>
+#include <iterator>
+#include <ranges>
+#include <utility>
+#include <vector>
+
+
+// the factors are multiplied pairwise in a balanced tree, so the operands
+// of every multiplication have comparable sizes
+BigInteger product(std::vector<BigInteger> factors);
+
+template <std::ranges::input_range Range>
+BigInteger product(Range&& range) {
+  std::vector<BigInteger> factors;
+  if constexpr (std::ranges::sized_range<Range>)
+    factors.reserve(std::ranges::size(range));
+
+  for (auto&& item : range) {
+    factors.emplace_back(item);
+  }
+
+  return product(std::move(factors));
+}
+
+// computed with the prime swing algorithm
+BigInteger factorial(std::uint64_t n);
+BigInteger binomial(std::uint64_t n, std::uint64_t k);
+
+#endif // COMBINATORICS_H_ //-------------------------------------------//
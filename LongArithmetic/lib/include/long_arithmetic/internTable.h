@@ -0,0 +1,44 @@
+#pragma once
+#ifndef INTERNTABLE_H_
+#define INTERNTABLE_H_
+
+#include "bigInteger.h"
+#include "bigIntegerView.h"
+
+#include <cstddef>
+#include <unordered_set>
+
+
+// keeps one copy of every distinct value: repeated constants share the
+// stored instance, and the returned references stay valid until the table
+// is cleared or destroyed. The table is not synchronised
+class InternTable {
+private:
+  struct Hash {
+    using is_transparent = void;
+
+    std::size_t operator()(const BigInteger& value) const noexcept;
+    std::size_t operator()(const BigIntegerView& value) const noexcept;
+  };
+
+  struct Equal {
+    using is_transparent = void;
+
+    bool operator()(const BigInteger& lhs, const BigInteger& rhs) const;
+    bool operator()(const BigIntegerView& lhs, const BigInteger& rhs) const;
+    bool operator()(const BigInteger& lhs, const BigIntegerView& rhs) const;
+  };
+
+  std::unordered_set<BigInteger, Hash, Equal> values_{};
+
+public:
+  const BigInteger& intern(const BigInteger& value);
+  const BigInteger& intern(BigInteger&& value);
+  // the view is copied only when the value is seen for the first time
+  const BigInteger& intern(const BigIntegerView& value);
+
+  std::size_t size() const noexcept;
+  void clear() noexcept;
+};
+
+#endif // INTERNTABLE_H_ //---------------------------------------------//
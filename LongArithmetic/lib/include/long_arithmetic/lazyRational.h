@@ -0,0 +1,60 @@
+#pragma once
+#ifndef LAZYRATIONAL_H_
+#define LAZYRATIONAL_H_
+
+#include "bigInteger.h"
+#include "rational.h"
+
+#include <compare>
+#include <cstddef>
+#include <iostream>
+#include <string>
+
+
+// rational arithmetic without a gcd after every operation: the fraction is
+// reduced only when the limbs of the numerator and the denominator together
+// exceed twice their count after the last reduction, and at least the
+// threshold, or when the value is read. Comparisons work on the unreduced
+// fraction. Sums and products in between the reductions are plain
+// integer arithmetic, a sum whose denominators differ only now and then is
+// cheaper in Rational, which cancels them term by term
+class LazyRational {
+private:
+  BigInteger num_{0};
+  BigInteger demon_{1};
+  std::size_t threshold_{kDefaultThreshold};
+  std::size_t trigger_{kDefaultThreshold};
+
+  std::size_t limbCount() const noexcept;
+  void reduceIfLarge();
+
+public:
+  static constexpr std::size_t kDefaultThreshold{1024};
+
+  LazyRational() = default;
+  LazyRational(const Rational& value,
+               std::size_t threshold = kDefaultThreshold);
+
+  std::size_t threshold() const noexcept;
+  void setThreshold(std::size_t threshold);
+
+  LazyRational& operator+=(const LazyRational& rhs);
+  LazyRational& operator-=(const LazyRational& rhs);
+  LazyRational& operator*=(const LazyRational& rhs);
+  LazyRational& operator/=(const LazyRational& rhs);
+
+  void reduce();
+  Rational value() const;
+  std::string toString() const;
+  std::strong_ordering operator<=>(const LazyRational& rhs) const;
+  bool operator==(const LazyRational& rhs) const;
+};
+
+LazyRational operator+(const LazyRational& lhs, const LazyRational& rhs);
+LazyRational operator-(const LazyRational& lhs, const LazyRational& rhs);
+LazyRational operator*(const LazyRational& lhs, const LazyRational& rhs);
+LazyRational operator/(const LazyRational& lhs, const LazyRational& rhs);
+
+std::ostream& operator<<(std::ostream& out, const LazyRational& rhs);
+
+#endif // LAZYRATIONAL_H_ //--------------------------------------------//
@@ -0,0 +1,53 @@
+#pragma once
+#ifndef PROFILING_H_
+#define PROFILING_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+
+
+enum class Operation {
+  Add,
+  Subtract,
+  Multiply,
+  Divide,
+  Remainder,
+  Gcd,
+  ToString,
+  Parse
+};
+
+inline constexpr std::size_t kOperationCount{8};
+// bucket 0 counts empty operands and bucket i limb counts in
+// [2^(i - 1), 2^i), the last bucket takes everything above
+inline constexpr std::size_t kSizeBuckets{32};
+
+struct OperationStats {
+  std::uint64_t count{0};
+  std::uint64_t nanoseconds{0};
+  std::array<std::uint64_t, kSizeBuckets> sizes{};
+};
+
+// called after every instrumented operation with its wall time and the
+// limb count of the larger operand
+using ProfileHook = void (*)(Operation operation, std::uint64_t nanoseconds,
+                             std::size_t limbs);
+
+// installs the hook, nullptr removes it. The library calls it only when it
+// is built with LONG_ARITHMETIC_PROFILE, otherwise the timing compiles away
+void setProfileHook(ProfileHook hook) noexcept;
+ProfileHook profileHook() noexcept;
+
+const char* operationName(Operation operation) noexcept;
+
+// with LONG_ARITHMETIC_PROFILE every thread counts its operations in its
+// own block without locks; the totals below add up the blocks of all
+// threads, the exited ones included. Without it they stay zero
+std::array<OperationStats, kOperationCount> operationStats();
+void resetOperationStats();
+// one line per operation that ran: count, time and the size histogram
+void dumpOperationStats(std::ostream& out);
+
+#endif // PROFILING_H_ //----------------------------------------------//
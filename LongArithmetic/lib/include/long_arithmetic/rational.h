@@ -3,15 +3,43 @@
 #define RATIONAL_H_
 
 #include "bigInteger.h"
+#include "rounding.h"
 
+#include <charconv>
+#include <cstdint>
 #include <iostream>
 #include <string>
+#include <string_view>
+#include <vector>
 
 
+// a value whose numerator and denominator fit a machine word is kept in
+// small_num_ and small_demon_ without touching the heap; num_ and demon_
+// hold it only once an operation overflows
 class Rational {
 private:
-  BigInteger num_{0};
-  BigInteger demon_{1};
+  std::int64_t small_num_{0};
+  std::int64_t small_demon_{1};
+  bool small_{true};
+  BigInteger num_{};
+  BigInteger demon_{};
+
+  static std::int64_t toWord(const BigInteger& number);
+  const BigInteger& bigNumerator(BigInteger& storage) const;
+  const BigInteger& bigDenominator(BigInteger& storage) const;
+  void promote();
+  void demote();
+  static void assignDigits(BigInteger& number, bool negative,
+                           std::string_view integer,
+                           std::string_view fraction);
+  void assign(bool negative, std::string_view integer,
+              std::string_view fraction, std::string_view denominator);
+
+  friend class BinaryReader;
+  friend class BinaryWriter;
+  friend bool operator==(const Rational& lhs, const Rational& rhs);
+  friend std::from_chars_result fromChars(const char* first, const char* last,
+                                          Rational& value);
 
 public:
   Rational() = default;
@@ -19,6 +47,13 @@ public:
   Rational(const BigInteger& num);
   Rational(int num);
 
+  // the exact value of a finite floating point number
+  static Rational fromDouble(double value);
+  static Rational fromLongDouble(long double value);
+
+  BigInteger numerator() const;
+  BigInteger denominator() const;
+
   Rational operator-() const;
 
   Rational& operator+=(const Rational& rhs);
@@ -27,12 +62,29 @@ public:
   Rational& operator/=(const Rational& rhs);
 
   std::string toString() const;
-  std::string asDecimal(std::size_t precision = 0) const;
+  // precision is the number of digits after the decimal point
+  std::string asDecimal(std::size_t precision = 0,
+                        RoundingMode rounding = RoundingMode::TowardZero) const;
+  // terms of the regular continued fraction, the first one is the floor
+  std::vector<BigInteger> continuedFraction() const;
+  // the closest rational with a denominator at most max_denominator
+  Rational limitDenominator(const BigInteger& max_denominator) const;
+  // rounded to nearest, ties to even
+  double toDouble() const;
+  long double toLongDouble() const;
   void swap(Rational& rhs);
   int compare(const Rational& rhs) const;
+  // reads one whitespace separated token in the form of fromChars
   std::istream& dump(std::istream& in);
 };
 
+// parses [sign] digits [/ digits | . digits] from the front of the range
+// like std::from_chars, without allocating for word-sized values. On
+// success ptr is one past the parsed text, on error ptr points at the
+// offending character, ec is invalid_argument and value is unchanged
+std::from_chars_result fromChars(const char* first, const char* last,
+                                 Rational& value);
+
 Rational operator+(const Rational& lhs, const Rational& rhs);
 Rational operator-(const Rational& lhs, const Rational& rhs);
 Rational operator*(const Rational& lhs, const Rational& rhs);
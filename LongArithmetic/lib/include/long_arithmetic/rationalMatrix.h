@@ -0,0 +1,47 @@
+#pragma once
+#ifndef RATIONALMATRIX_H_
+#define RATIONALMATRIX_H_
+
+#include "bigInteger.h"
+#include "rational.h"
+
+#include <cstddef>
+#include <initializer_list>
+#include <vector>
+
+
+// dense row-major matrix of rationals. determinant, rank and solve scale
+// every row to integers and run Bareiss fraction-free elimination over
+// BigInteger: each division there is exact, so no gcd is taken until the
+// results are turned back into rationals
+class RationalMatrix {
+private:
+  std::size_t rows_{0};
+  std::size_t cols_{0};
+  std::vector<Rational> values_{};
+
+  std::vector<BigInteger> integerRows(BigInteger* scale) const;
+
+public:
+  RationalMatrix() = default;
+  RationalMatrix(std::size_t rows, std::size_t cols);
+  RationalMatrix(std::initializer_list<std::initializer_list<Rational>> rows);
+
+  static RationalMatrix identity(std::size_t size);
+
+  std::size_t rows() const noexcept;
+  std::size_t cols() const noexcept;
+
+  Rational& operator()(std::size_t row, std::size_t col);
+  const Rational& operator()(std::size_t row, std::size_t col) const;
+
+  Rational determinant() const;
+  std::size_t rank() const;
+  // the solution of A x = rhs for a square non-singular A
+  std::vector<Rational> solve(const std::vector<Rational>& rhs) const;
+};
+
+bool operator==(const RationalMatrix& lhs, const RationalMatrix& rhs);
+bool operator!=(const RationalMatrix& lhs, const RationalMatrix& rhs);
+
+#endif // RATIONALMATRIX_H_ //------------------------------------------//
@@ -0,0 +1,25 @@
+#pragma once
+#ifndef ROUNDING_H_
+#define ROUNDING_H_
+
+
+enum class RoundingMode {
+  HalfEven,
+  HalfAwayFromZero,
+  TowardZero,
+  AwayFromZero,
+  Floor,
+  Ceiling
+};
+
+namespace details {
+
+// whether the magnitude truncated towards zero has to be incremented;
+// half is the comparison of the discarded part with one half (-1, 0 or 1)
+// and exact tells that nothing was discarded
+bool roundAway(RoundingMode mode, bool negative, bool odd,
+               int half, bool exact);
+
+} // namespace details //-----------------------------------------------//
+
+#endif // ROUNDING_H_ //------------------------------------------------//
@@ -0,0 +1,86 @@
+#pragma once
+#ifndef SERIALIZATION_H_
+#define SERIALIZATION_H_
+
+#include "bigInteger.h"
+#include "rational.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+
+// binary layout of a BigInteger:
+//   - one byte with the sign, 1 for negative numbers
+//   - the digit count as 8 bytes little-endian
+//   - the decimal digits packed two per byte, least significant first:
+//     the even digits in the low nibbles, the odd ones in the high
+//     nibbles, and a zero high nibble pads an odd count
+// A Rational is its numerator followed by its denominator. The reader
+// accepts the canonical form only and leaves the target unchanged on
+// errors
+
+class BinaryWriter {
+private:
+  std::ostream& out_;
+  std::vector<char> buffer_{};
+
+  void put(char byte);
+
+public:
+  explicit BinaryWriter(std::ostream& out, std::size_t buffer_size = 1 << 16);
+  BinaryWriter(const BinaryWriter&) = delete;
+  BinaryWriter& operator=(const BinaryWriter&) = delete;
+  ~BinaryWriter();
+
+  void write(const BigInteger& value);
+  void write(const Rational& value);
+  void flush();
+};
+
+class BinaryReader {
+private:
+  std::istream& in_;
+  std::vector<char> buffer_{};
+  std::size_t pos_{0};
+  std::size_t end_{0};
+
+  bool fill();
+  char get();
+
+public:
+  explicit BinaryReader(std::istream& in, std::size_t buffer_size = 1 << 16);
+  BinaryReader(const BinaryReader&) = delete;
+  BinaryReader& operator=(const BinaryReader&) = delete;
+
+  // false when the stream ended before the next value
+  bool read(BigInteger& value);
+  bool read(Rational& value);
+};
+
+// whitespace separated rationals in the text form of fromChars, parsed
+// straight from the buffer; errors name the line and the column
+class TextReader {
+private:
+  std::istream& in_;
+  std::vector<char> buffer_{};
+  std::size_t pos_{0};
+  std::size_t end_{0};
+  // stream offsets of buffer_[0] and of the current line
+  std::size_t offset_{0};
+  std::size_t line_start_{0};
+  std::size_t line_{1};
+
+  bool fill();
+
+public:
+  explicit TextReader(std::istream& in, std::size_t buffer_size = 1 << 16);
+  TextReader(const TextReader&) = delete;
+  TextReader& operator=(const TextReader&) = delete;
+
+  // false when only whitespace is left
+  bool read(Rational& value);
+};
+
+#endif // SERIALIZATION_H_ //-------------------------------------------//
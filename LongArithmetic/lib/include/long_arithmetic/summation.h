@@ -0,0 +1,25 @@
+#pragma once
+#ifndef SUMMATION_H_
+#define SUMMATION_H_
+
+#include "bigInteger.h"
+#include "rational.h"
+
+#include <cstddef>
+#include <span>
+
+
+// the terms are cut into chunks that a pool of threads sums, and the chunk
+// sums are merged pairwise in a balanced tree, every round in parallel on
+// the same threads. Rational terms of a chunk are summed pairwise too,
+// which keeps the intermediate denominators small. threads == 0 uses the
+// hardware concurrency
+BigInteger sum(std::span<const BigInteger> terms, std::size_t threads = 0);
+Rational sum(std::span<const Rational> terms, std::size_t threads = 0);
+
+BigInteger dot(std::span<const BigInteger> lhs,
+               std::span<const BigInteger> rhs, std::size_t threads = 0);
+Rational dot(std::span<const Rational> lhs, std::span<const Rational> rhs,
+             std::size_t threads = 0);
+
+#endif // SUMMATION_H_ //-----------------------------------------------//
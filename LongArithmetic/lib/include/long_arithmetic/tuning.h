@@ -0,0 +1,21 @@
+#pragma once
+#ifndef TUNING_H_
+#define TUNING_H_
+
+#include <cstddef>
+
+
+// crossover points of the BigInteger algorithms in limbs. The library
+// starts with the values of the header written by long_arithmetic_tune
+// when it is configured with LONG_ARITHMETIC_THRESHOLDS, otherwise with
+// fixed defaults
+struct Thresholds {
+  // products whose shorter operand has this many limbs use Karatsuba
+  std::size_t karatsuba;
+};
+
+Thresholds thresholds() noexcept;
+// meant for measurements, karatsuba is raised to 2 at least
+void setThresholds(const Thresholds& value) noexcept;
+
+#endif // TUNING_H_ //-------------------------------------------------//
@@ -0,0 +1,383 @@
+#include "long_arithmetic/bigFloat.h"
+
+#include <algorithm>
+#include <cctype>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <limits>
+#include <string>
+
+
+namespace details {
+
+// the largest exponent distance printed without the scientific notation
+constexpr std::int64_t kPlainLimit{20};
+
+std::int64_t parseExponent(const std::string& str, std::size_t pos) {
+  bool negative = false;
+  if (pos < str.size() && (str[pos] == '-' || str[pos] == '+'))
+    negative = str[pos++] == '-';
+
+  if (pos == str.size())
+    throw std::runtime_error("malformed number: " + str);
+
+  std::int64_t res{0};
+  for (; pos != str.size(); ++pos) {
+    if (!std::isdigit(static_cast<unsigned char>(str[pos])) ||
+        res > (std::numeric_limits<std::int64_t>::max() - 9) / 10) {
+      throw std::runtime_error("malformed number: " + str);
+    }
+
+    res = res * 10 + (str[pos] - '0');
+  }
+
+  return negative ? -res : res;
+}
+
+BigInteger isqrt(const BigInteger& number) {
+  // Newton's iteration decreases monotonically from any start above the root
+  auto digits = number.digitCountEstimate();
+  BigInteger res{"1" + std::string((digits + 1) / 2, '0')};
+  while (true) {
+    auto next = (res + number / res) / 2;
+    if (next >= res)
+      return res;
+
+    res = std::move(next);
+  }
+}
+
+} // namespace details //-----------------------------------------------//
+
+// BigFloat implementation //-------------------------------------------//
+BigFloat::BigFloat(const BigInteger& value, std::size_t precision,
+                   RoundingMode rounding)
+    : mantissa_{value}, precision_{std::max<std::size_t>(precision, 1)},
+      rounding_{rounding} {
+  normalize();
+}
+
+BigFloat::BigFloat(const std::string& number_str, std::size_t precision,
+                   RoundingMode rounding)
+    : precision_{std::max<std::size_t>(precision, 1)}, rounding_{rounding} {
+  std::string digits{};
+  std::size_t pos{0};
+  bool negative = false;
+  if (pos < number_str.size() &&
+      (number_str[pos] == '-' || number_str[pos] == '+')) {
+    negative = number_str[pos++] == '-';
+  }
+
+  bool has_point = false;
+  std::int64_t fraction_digits{0};
+  for (; pos != number_str.size(); ++pos) {
+    auto item = number_str[pos];
+    if (std::isdigit(static_cast<unsigned char>(item))) {
+      digits.push_back(item);
+      fraction_digits += has_point;
+    } else if (item == '.' && !has_point) {
+      has_point = true;
+    } else {
+      break;
+    }
+  }
+
+  if (digits.empty())
+    throw std::runtime_error("malformed number: " + number_str);
+
+  exponent_ = -fraction_digits;
+  if (pos != number_str.size()) {
+    if (number_str[pos] != 'e' && number_str[pos] != 'E')
+      throw std::runtime_error("malformed number: " + number_str);
+
+    exponent_ += details::parseExponent(number_str, pos + 1);
+  }
+
+  mantissa_ = BigInteger{negative ? "-" + digits : digits};
+  normalize();
+}
+
+std::int64_t BigFloat::digitCount(const BigInteger& number) {
+  return static_cast<std::int64_t>(number.number_.size());
+}
+
+// drops the count lowest digits and compares them with one half
+int BigFloat::dropDigits(BigInteger& number, std::int64_t count,
+                         bool& exact) {
+  auto& digits = number.number_;
+  auto size = static_cast<std::int64_t>(digits.size());
+  auto first = count <= size ? digits[count - 1] : 0;
+  auto rest = std::min(count - 1, size);
+  exact = first == 0;
+  bool sticky = false;
+  for (std::int64_t i = 0; i < rest; ++i) {
+    sticky |= digits[i] != 0;
+  }
+
+  exact &= !sticky;
+  digits.erase(std::begin(digits), std::begin(digits) + std::min(count, size));
+  if (digits.empty())
+    number.sign_ = 1;
+
+  if (first != 5)
+    return first < 5 ? -1 : 1;
+
+  return sticky ? 1 : 0;
+}
+
+void BigFloat::normalize() {
+  if (!mantissa_) {
+    exponent_ = 0;
+    return;
+  }
+
+  auto excess = digitCount(mantissa_) - static_cast<std::int64_t>(precision_);
+  if (excess > 0) {
+    bool negative = mantissa_ < 0;
+    bool exact = true;
+    auto half = dropDigits(mantissa_, excess, exact);
+    exponent_ += excess;
+    bool odd = mantissa_.number_.front() % 2;
+    if (details::roundAway(rounding_, negative, odd, half, exact))
+      mantissa_ += negative ? -1 : 1;
+  }
+
+  auto& digits = mantissa_.number_;
+  auto zeros = std::find_if(std::begin(digits), std::end(digits),
+                            [](int item) { return item != 0; });
+  exponent_ += zeros - std::begin(digits);
+  digits.erase(std::begin(digits), zeros);
+}
+
+// the exponent only moves the digits, so it is applied after the rounding
+BigFloat BigFloat::fromParts(const BigInteger& mantissa,
+                             std::int64_t exponent, std::size_t precision,
+                             RoundingMode rounding) {
+  BigFloat res{mantissa, precision, rounding};
+  if (res.mantissa_)
+    res.exponent_ += exponent;
+
+  return res;
+}
+
+const BigInteger& BigFloat::mantissa() const noexcept {
+  return mantissa_;
+}
+
+std::int64_t BigFloat::exponent() const noexcept {
+  return exponent_;
+}
+
+std::size_t BigFloat::precision() const noexcept {
+  return precision_;
+}
+
+RoundingMode BigFloat::rounding() const noexcept {
+  return rounding_;
+}
+
+void BigFloat::setPrecision(std::size_t precision) {
+  precision_ = std::max<std::size_t>(precision, 1);
+  normalize();
+}
+
+void BigFloat::setRounding(RoundingMode rounding) noexcept {
+  rounding_ = rounding;
+}
+
+BigFloat BigFloat::operator-() const {
+  auto tmp{*this};
+  tmp.mantissa_ = -tmp.mantissa_;
+  return tmp;
+}
+
+BigFloat& BigFloat::operator+=(const BigFloat& rhs) {
+  if (!rhs.mantissa_)
+    return *this;
+
+  auto other = rhs.mantissa_;
+  auto other_exponent = rhs.exponent_;
+  if (!mantissa_) {
+    mantissa_.swap(other);
+    exponent_ = other_exponent;
+    normalize();
+    return *this;
+  }
+
+  // an operand entirely below the rounding digits of the other one only
+  // decides the rounding, so it is replaced by a unit further below them
+  // instead of being aligned digit by digit
+  auto top = exponent_ + digitCount(mantissa_);
+  auto other_top = other_exponent + digitCount(other);
+  auto guard = static_cast<std::int64_t>(precision_) + 3;
+  if (top - other_top > guard) {
+    other = other < 0 ? -1 : 1;
+    other_exponent = top - guard - 2;
+  } else if (other_top - top > guard) {
+    mantissa_ = mantissa_ < 0 ? -1 : 1;
+    exponent_ = other_top - guard - 2;
+  }
+
+  auto exponent = std::min(exponent_, other_exponent);
+  mantissa_.shiftLeft(exponent_ - exponent);
+  other.shiftLeft(other_exponent - exponent);
+  mantissa_ += other;
+  exponent_ = exponent;
+  normalize();
+  return *this;
+}
+
+BigFloat& BigFloat::operator-=(const BigFloat& rhs) {
+  *this += -rhs;
+  return *this;
+}
+
+BigFloat& BigFloat::operator*=(const BigFloat& rhs) {
+  mantissa_ *= rhs.mantissa_;
+  exponent_ += rhs.exponent_;
+  normalize();
+  return *this;
+}
+
+BigFloat& BigFloat::operator/=(const BigFloat& rhs) {
+  if (!rhs.mantissa_)
+    throw std::runtime_error("division by zero");
+
+  if (!mantissa_)
+    return *this;
+
+  bool negative = (mantissa_ < 0) != (rhs.mantissa_ < 0);
+  auto numerator = abs(mantissa_);
+  auto denominator = abs(rhs.mantissa_);
+
+  // the quotient gets one digit more than the precision, and a non-zero
+  // remainder is kept as a sticky digit below it
+  auto shift = std::max<std::int64_t>(
+      0, static_cast<std::int64_t>(precision_) + 1 +
+             digitCount(denominator) - digitCount(numerator));
+  numerator.shiftLeft(shift);
+  auto quotient = numerator / denominator;
+  exponent_ -= rhs.exponent_ + shift;
+  if (quotient * denominator != numerator) {
+    quotient.shiftLeft(1);
+    quotient += 1;
+    --exponent_;
+  }
+
+  mantissa_ = negative ? -quotient : quotient;
+  normalize();
+  return *this;
+}
+
+std::string BigFloat::toString() const {
+  if (!mantissa_)
+    return "0";
+
+  auto digits = abs(mantissa_).toString();
+  auto size = static_cast<std::int64_t>(digits.size());
+  auto point = exponent_ + size;
+  std::string res{mantissa_ < 0 ? "-" : ""};
+  if (exponent_ >= 0 && exponent_ <= details::kPlainLimit) {
+    res += digits + std::string(exponent_, '0');
+  } else if (exponent_ < 0 && point > 0) {
+    res += digits.substr(0, point) + "." + digits.substr(point);
+  } else if (exponent_ < 0 && -point <= details::kPlainLimit) {
+    res += "0." + std::string(-point, '0') + digits;
+  } else {
+    res += digits.substr(0, 1);
+    if (size > 1)
+      res += "." + digits.substr(1);
+
+    res += "e" + std::to_string(point - 1);
+  }
+
+  return res;
+}
+
+std::strong_ordering BigFloat::operator<=>(const BigFloat& rhs) const {
+  auto lhs_sign = mantissa_ <=> 0;
+  auto rhs_sign = rhs.mantissa_ <=> 0;
+  if (lhs_sign != rhs_sign)
+    return mantissa_ <=> rhs.mantissa_;
+
+  if (lhs_sign == 0)
+    return std::strong_ordering::equal;
+
+  bool negative = lhs_sign < 0;
+  auto top = exponent_ + digitCount(mantissa_);
+  auto rhs_top = rhs.exponent_ + digitCount(rhs.mantissa_);
+  if (top != rhs_top)
+    return negative ? rhs_top <=> top : top <=> rhs_top;
+
+  auto lhs_mantissa = mantissa_;
+  auto rhs_mantissa = rhs.mantissa_;
+  auto exponent = std::min(exponent_, rhs.exponent_);
+  lhs_mantissa.shiftLeft(exponent_ - exponent);
+  rhs_mantissa.shiftLeft(rhs.exponent_ - exponent);
+  return lhs_mantissa <=> rhs_mantissa;
+}
+
+BigFloat operator+(const BigFloat& lhs, const BigFloat& rhs) {
+  auto tmp{lhs};
+  tmp += rhs;
+  return tmp;
+}
+
+BigFloat operator-(const BigFloat& lhs, const BigFloat& rhs) {
+  auto tmp{lhs};
+  tmp -= rhs;
+  return tmp;
+}
+
+BigFloat operator*(const BigFloat& lhs, const BigFloat& rhs) {
+  auto tmp{lhs};
+  tmp *= rhs;
+  return tmp;
+}
+
+BigFloat operator/(const BigFloat& lhs, const BigFloat& rhs) {
+  auto tmp{lhs};
+  tmp /= rhs;
+  return tmp;
+}
+
+// the values are kept normalised, so equal numbers have equal parts
+bool operator==(const BigFloat& lhs, const BigFloat& rhs) {
+  return lhs.mantissa() == rhs.mantissa() &&
+         lhs.exponent() == rhs.exponent();
+}
+
+std::ostream& operator<<(std::ostream& out, const BigFloat& rhs) {
+  out << rhs.toString();
+  return out;
+}
+
+BigFloat sqrt(const BigFloat& number) {
+  if (number.mantissa_ < 0)
+    throw std::runtime_error("square root of a negative number");
+
+  if (!number.mantissa_)
+    return number;
+
+  // a radicand of at least 2 * (precision + 1) digits with an even exponent
+  auto precision = static_cast<std::int64_t>(number.precision_);
+  auto shift = std::max<std::int64_t>(
+      0, 2 * (precision + 1) - BigFloat::digitCount(number.mantissa_));
+  if ((number.exponent_ - shift) % 2 != 0)
+    ++shift;
+
+  auto radicand = number.mantissa_;
+  radicand.shiftLeft(shift);
+  auto root = details::isqrt(radicand);
+  auto exponent = (number.exponent_ - shift) / 2;
+  if (root * root != radicand) {
+    root.shiftLeft(1);
+    root += 1;
+    --exponent;
+  }
+
+  return BigFloat::fromParts(root, exponent, number.precision_,
+                             number.rounding_);
+}
@@ -1,9 +1,23 @@
 #include "long_arithmetic/bigInteger.h"
+#include "long_arithmetic/bigIntegerView.h"
+#include "long_arithmetic/tuning.h"
+#include "limbHash.h"
+#include "profileScope.h"
+
+#ifdef LONG_ARITHMETIC_THRESHOLDS_HEADER
+#include LONG_ARITHMETIC_THRESHOLDS_HEADER
+#endif
 
 #include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cmath>
 #include <cstddef>
+#include <cstdint>
 #include <exception>
+#include <limits>
 #include <iostream>
+#include <numeric>
 #include <string>
 #include <vector>
 #include <utility>
@@ -11,12 +25,90 @@
 
 namespace details {
 
+#ifndef LONG_ARITHMETIC_THRESHOLDS_HEADER
+constexpr std::size_t kKaratsubaThreshold{48};
+#endif
+
+// any number with this many digits fits into std::int64_t
+constexpr std::size_t kWordDigits{18};
+
+// below two limbs the Karatsuba split would not make the operands smaller
+constexpr std::size_t kMinKaratsubaThreshold{2};
+
+std::atomic<std::size_t> karatsuba_threshold{
+    std::max(kKaratsubaThreshold, kMinKaratsubaThreshold)};
+
+// limb buffers of intermediate results are taken from a thread local pool
+// and given back once they are dead, so arithmetic loops reuse memory
+// instead of going to the global heap for every temporary. The limbs kept
+// by a thread are capped in total, so one huge product does not pin its
+// temporaries for the rest of the thread
+class ScratchPool {
+private:
+  static constexpr std::size_t kMaxBuffers{32};
+  // 4 MB of int limbs
+  static constexpr std::size_t kMaxRetained{std::size_t{1} << 20};
+
+  std::vector<std::vector<int>> buffers_{};
+  std::size_t retained_{0};
+
+public:
+  std::vector<int> acquire(std::size_t size) {
+    std::vector<int> res{};
+    if (!buffers_.empty()) {
+      // the smallest buffer which fits, otherwise the largest one
+      std::size_t best{0};
+      for (std::size_t i = 1; i != buffers_.size(); ++i) {
+        auto current = buffers_[i].capacity();
+        auto chosen = buffers_[best].capacity();
+        if (chosen < size ? current > chosen
+                          : current >= size && current < chosen) {
+          best = i;
+        }
+      }
+
+      res = std::move(buffers_[best]);
+      retained_ -= res.capacity();
+      buffers_[best] = std::move(buffers_.back());
+      buffers_.pop_back();
+    }
+
+    res.assign(size, 0);
+    return res;
+  }
+
+  template <typename Iterator>
+  std::vector<int> acquire(Iterator first, Iterator last) {
+    auto res = acquire(0);
+    res.assign(first, last);
+    return res;
+  }
+
+  void release(std::vector<int>& buffer) {
+    if (buffers_.size() < kMaxBuffers && buffer.capacity() &&
+        buffer.capacity() <= kMaxRetained - retained_) {
+      auto capacity = buffer.capacity();
+      buffer.clear();
+      buffers_.push_back(std::move(buffer));
+      retained_ += capacity;
+    }
+
+    buffer = std::vector<int>{};
+  }
+};
+
+ScratchPool& scratchPool() {
+  thread_local ScratchPool pool;
+  return pool;
+}
+
 void removeZeros(std::vector<int>& number) {
   while (!number.empty() && number.back() == 0) {
     number.pop_back();
   }
 }
 
+// digits may be negative as long as the whole number is not
 void toBase10(std::vector<int>& number) {
   int accumulator{0};
   for (std::size_t i = 0; accumulator || i < number.size(); ++i) {
@@ -24,10 +116,17 @@ void toBase10(std::vector<int>& number) {
     accumulator += number[i];
     number[i] = accumulator % 10;
     accumulator /= 10;
+    if (number[i] < 0) {
+      number[i] += 10;
+      --accumulator;
+    }
   }
 }
 
-int absCompare(const std::vector<int>& lhs, const std::vector<int>& rhs,
+// the right-hand limbs may come from a BigInteger or from a BigIntegerView
+
+template <typename Limbs>
+int absCompare(const std::vector<int>& lhs, const Limbs& rhs,
                std::size_t pos = 0) {
   if (lhs.size() < rhs.size() + pos)
     return -1;
@@ -43,7 +142,8 @@ int absCompare(const std::vector<int>& lhs, const std::vector<int>& rhs,
   return 0;
 }
 
-void absSubstraction(std::vector<int>& lhs, const std::vector<int>& rhs,
+template <typename Limbs>
+void absSubstraction(std::vector<int>& lhs, const Limbs& rhs,
                      std::size_t pos = 0) {
   for (std::size_t i = 0; i + pos != lhs.size(); ++i) {
     if (i < rhs.size())
@@ -56,8 +156,144 @@ void absSubstraction(std::vector<int>& lhs, const std::vector<int>& rhs,
   }
 }
 
-std::vector<int> devide(std::vector<int>& lhs, const std::vector<int>& rhs) {
-  std::vector<int> tmp(lhs.size(), 0);
+template <typename Limbs>
+void addShifted(std::vector<int>& lhs, const Limbs& rhs,
+                std::size_t pos, int factor = 1) {
+  if (lhs.size() < rhs.size() + pos)
+    lhs.resize(rhs.size() + pos, 0);
+
+  for (std::size_t i = 0; i != rhs.size(); ++i) {
+    lhs[i + pos] += factor * rhs[i];
+  }
+}
+
+// lhs = |lhs - rhs|, returns -1 when rhs was the larger one
+template <typename Limbs>
+int absDifference(std::vector<int>& lhs, const Limbs& rhs) {
+  auto cmp = absCompare(lhs, rhs);
+  if (cmp == 0) {
+    lhs.clear();
+    return 1;
+  }
+
+  if (cmp > 0) {
+    absSubstraction(lhs, rhs);
+    removeZeros(lhs);
+    return 1;
+  }
+
+  auto& pool = scratchPool();
+  auto tmp = pool.acquire(std::begin(rhs), std::end(rhs));
+  absSubstraction(tmp, lhs);
+  removeZeros(tmp);
+  lhs.swap(tmp);
+  pool.release(tmp);
+  return -1;
+}
+
+std::vector<int> multiplySchoolbook(const int* lhs, std::size_t lhs_size,
+                                    const int* rhs, std::size_t rhs_size) {
+  auto accumulator = scratchPool().acquire(lhs_size + rhs_size);
+  for (std::size_t j = 0; j != rhs_size; ++j) {
+    for (std::size_t k = 0; k != lhs_size; ++k) {
+      accumulator[k + j] += lhs[k] * rhs[j];
+    }
+  }
+
+  toBase10(accumulator);
+  removeZeros(accumulator);
+  return accumulator;
+}
+
+// lhs_size >= rhs_size is expected
+std::vector<int> multiplyKaratsuba(const int* lhs, std::size_t lhs_size,
+                                   const int* rhs, std::size_t rhs_size,
+                                   std::size_t threshold) {
+  if (rhs_size < threshold)
+    return multiplySchoolbook(lhs, lhs_size, rhs, rhs_size);
+
+  auto& pool = scratchPool();
+  auto res = pool.acquire(0);
+  if (2 * rhs_size <= lhs_size) {
+    // unbalanced operands: multiply rhs by lhs chunks of the rhs length
+    for (std::size_t pos = 0; pos < lhs_size; pos += rhs_size) {
+      auto chunk_size = std::min(rhs_size, lhs_size - pos);
+      auto chunk = chunk_size < rhs_size
+          ? multiplyKaratsuba(rhs, rhs_size, lhs + pos, chunk_size,
+                              threshold)
+          : multiplyKaratsuba(lhs + pos, chunk_size, rhs, rhs_size,
+                              threshold);
+      addShifted(res, chunk, pos);
+      pool.release(chunk);
+    }
+
+    toBase10(res);
+    removeZeros(res);
+    return res;
+  }
+
+  auto half = lhs_size / 2;
+  auto low_lhs = pool.acquire(lhs, lhs + half);
+  auto high_lhs = pool.acquire(lhs + half, lhs + lhs_size);
+  auto low_rhs = pool.acquire(rhs, rhs + half);
+  auto high_rhs = pool.acquire(rhs + half, rhs + rhs_size);
+  removeZeros(low_lhs);
+  removeZeros(low_rhs);
+
+  auto multiplyParts = [&pool, threshold](const std::vector<int>& x,
+                                          const std::vector<int>& y) {
+    if (x.empty() || y.empty())
+      return pool.acquire(0);
+
+    return x.size() < y.size()
+        ? multiplyKaratsuba(y.data(), y.size(), x.data(), x.size(), threshold)
+        : multiplyKaratsuba(x.data(), x.size(), y.data(), y.size(), threshold);
+  };
+
+  auto low = multiplyParts(low_lhs, low_rhs);
+  auto high = multiplyParts(high_lhs, high_rhs);
+
+  addShifted(low_lhs, high_lhs, 0);
+  toBase10(low_lhs);
+  addShifted(low_rhs, high_rhs, 0);
+  toBase10(low_rhs);
+  auto middle = multiplyParts(low_lhs, low_rhs);
+  addShifted(middle, low, 0, -1);
+  addShifted(middle, high, 0, -1);
+
+  res.assign(lhs_size + rhs_size, 0);
+  addShifted(res, low, 0);
+  addShifted(res, middle, half);
+  addShifted(res, high, 2 * half);
+  toBase10(res);
+  removeZeros(res);
+
+  for (auto* buffer : {&low_lhs, &high_lhs, &low_rhs, &high_rhs,
+                       &low, &middle, &high}) {
+    pool.release(*buffer);
+  }
+
+  return res;
+}
+
+std::vector<int> multiply(const std::vector<int>& lhs,
+                          const std::vector<int>& rhs) {
+  if (lhs.empty() || rhs.empty())
+    return {};
+
+  auto threshold = karatsuba_threshold.load(std::memory_order_relaxed);
+  if (lhs.size() < rhs.size())
+    return multiplyKaratsuba(rhs.data(), rhs.size(), lhs.data(), lhs.size(),
+                             threshold);
+
+  return multiplyKaratsuba(lhs.data(), lhs.size(), rhs.data(), rhs.size(),
+                           threshold);
+}
+
+// leaves the normalized remainder in lhs
+template <typename Limbs>
+std::vector<int> devide(std::vector<int>& lhs, const Limbs& rhs) {
+  auto tmp = scratchPool().acquire(lhs.size());
   for (std::size_t i = tmp.size(); i--;) {
     for (std::size_t j = 0; j != 9; ++j) {
       removeZeros(lhs);
@@ -70,21 +306,213 @@ std::vector<int> devide(std::vector<int>& lhs, const std::vector<int>& rhs) {
     }
   }
 
+  // the ninth subtraction of a digit is not followed by a check
+  removeZeros(lhs);
   return tmp;
 }
 
+template <typename Limbs>
+void add(int& sign, std::vector<int>& number,
+         int rhs_sign, const Limbs& rhs) {
+  if (sign == rhs_sign) {
+    addShifted(number, rhs, 0);
+    toBase10(number);
+  } else {
+    sign *= absDifference(number, rhs);
+  }
+
+  if (number.empty()) sign = 1;
+}
+
+template <typename Limbs>
+void divide(int& sign, std::vector<int>& number,
+            int rhs_sign, const Limbs& rhs) {
+  if (rhs.empty())
+    throw std::runtime_error("division by zero");
+
+  auto quotient = devide(number, rhs);
+  scratchPool().release(number);
+  number = std::move(quotient);
+  removeZeros(number);
+  number.empty() ? sign = 1 : sign *= rhs_sign;
+}
+
+// truncating division: the remainder keeps the sign of the dividend
+template <typename Limbs>
+void remainder(int& sign, std::vector<int>& number, const Limbs& rhs) {
+  if (rhs.empty())
+    throw std::runtime_error("Division by zero.");
+
+  auto quotient = devide(number, rhs);
+  scratchPool().release(quotient);
+  if (number.empty()) sign = 1;
+}
+
+// Lehmer's gcd runs Euclid on the leading digits of both numbers and
+// applies the quotients it collected to the full numbers in one linear
+// pass. With 16 digits the cofactors stay below 10^16, so a limb times a
+// cofactor plus the carry fits std::int64_t
+constexpr std::size_t kLehmerDigits{16};
+
+std::int64_t leadingWord(const std::vector<int>& number, std::size_t shift) {
+  std::int64_t res{0};
+  for (auto i = number.size(); i-- > shift;) {
+    res = res * 10 + number[i];
+  }
+
+  return res;
+}
+
+// lhs * lhs_factor + rhs * rhs_factor for a non-negative result
+std::vector<int> combine(const std::vector<int>& lhs, std::int64_t lhs_factor,
+                         const std::vector<int>& rhs,
+                         std::int64_t rhs_factor) {
+  std::vector<int> res(std::max(lhs.size(), rhs.size()));
+  std::int64_t carry{0};
+  for (std::size_t i = 0; i != res.size(); ++i) {
+    auto value = carry;
+    if (i < lhs.size())
+      value += lhs[i] * lhs_factor;
+
+    if (i < rhs.size())
+      value += rhs[i] * rhs_factor;
+
+    carry = value / 10;
+    auto digit = static_cast<int>(value % 10);
+    if (digit < 0) {
+      digit += 10;
+      --carry;
+    }
+
+    res[i] = digit;
+  }
+
+  for (; carry; carry /= 10) {
+    res.push_back(static_cast<int>(carry % 10));
+  }
+
+  removeZeros(res);
+  return res;
+}
+
+// Knuth's algorithm L for lhs >= rhs > 0: the word quotients are taken
+// only while both bounds of the leading digits agree on them, so they are
+// the quotients of the full numbers. False when not even one quotient is
+// certain, then a full division has to make the step
+bool lehmerStep(std::vector<int>& lhs, std::vector<int>& rhs) {
+  if (lhs.size() <= kLehmerDigits)
+    return false;
+
+  auto shift = lhs.size() - kLehmerDigits;
+  auto x = leadingWord(lhs, shift);
+  auto y = leadingWord(rhs, shift);
+  std::int64_t a{1};
+  std::int64_t b{0};
+  std::int64_t c{0};
+  std::int64_t d{1};
+  while (y + c > 0 && y + d > 0 && x + a >= 0 && x + b >= 0) {
+    auto quotient = (x + a) / (y + c);
+    if (quotient != (x + b) / (y + d))
+      break;
+
+    auto tmp = a - quotient * c;
+    a = c;
+    c = tmp;
+    tmp = b - quotient * d;
+    b = d;
+    d = tmp;
+    tmp = x - quotient * y;
+    x = y;
+    y = tmp;
+  }
+
+  if (b == 0)
+    return false;
+
+  auto next = combine(lhs, a, rhs, b);
+  rhs = combine(lhs, c, rhs, d);
+  lhs = std::move(next);
+  return true;
+}
+
 } // namespace details //-----------------------------------------------//
 
 // BigInteger implementation //-----------------------------------------//
-BigInteger::BigInteger(int number) {
+// the scaled quotient num * 2^shift / denom is taken with exactly the
+// mantissa width of Float (less for subnormals) and its remainder decides
+// the rounding, so one division is enough unless the shift estimated
+// from the digit counts has to be corrected
+template <typename Float>
+Float BigInteger::ratioToFloat(const BigInteger& num,
+                               const BigInteger& denom) {
+  using Limits = std::numeric_limits<Float>;
+  constexpr long long kDigits{Limits::digits};
+  constexpr long long kMaxShift{kDigits - Limits::min_exponent};
+  constexpr long double kLog2Of10{3.32192809488736234787L};
+  if (!num)
+    return Float{0};
+
+  // 10^(scale - 1) < |num / denom| < 10^(scale + 1)
+  auto scale = static_cast<long long>(num.limbCount()) -
+               static_cast<long long>(denom.limbCount());
+  auto upper = static_cast<long long>(std::ceil((scale + 1) * kLog2Of10));
+  auto lower = static_cast<long long>(std::floor((scale - 1) * kLog2Of10));
+  auto negative = num.sign_ < 0;
+  if (lower >= Limits::max_exponent)
+    return negative ? -Limits::infinity() : Limits::infinity();
+
+  if (upper <= Limits::min_exponent - kDigits - 1)
+    return negative ? -Float{0} : Float{0};
+
+  auto shift = std::min(kDigits - upper, kMaxShift);
+  auto magnitude = abs(num);
+  while (true) {
+    auto dividend = shift > 0
+                        ? magnitude * pow2(static_cast<std::size_t>(shift))
+                        : magnitude;
+    auto divisor = shift < 0
+                       ? denom * pow2(static_cast<std::size_t>(-shift))
+                       : denom;
+    auto quotient = dividend / divisor;
+    auto remainder = dividend - quotient * divisor;
+
+    std::uint64_t word{0};
+    for (auto it = quotient.number_.rbegin(); it != quotient.number_.rend();
+         ++it)
+      word = word * 10 + static_cast<std::uint64_t>(*it);
+
+    auto width = static_cast<long long>(std::bit_width(word));
+    if (width < kDigits && shift < kMaxShift) {
+      shift = std::min(shift + kDigits - width, kMaxShift);
+      continue;
+    }
+
+    auto half = (remainder + remainder) <=> divisor;
+    auto mantissa = static_cast<Float>(word);
+    if (half > 0 || (half == 0 && word % 2))
+      mantissa += 1;
+
+    auto res = std::ldexp(mantissa, static_cast<int>(-shift));
+    return negative ? -res : res;
+  }
+}
+
+template double BigInteger::ratioToFloat<double>(const BigInteger& num,
+                                                 const BigInteger& denom);
+template long double BigInteger::ratioToFloat<long double>(
+    const BigInteger& num, const BigInteger& denom);
+
+BigInteger::BigInteger(long long number) {
+  // the magnitude is taken as unsigned to keep the minimal value representable
+  auto magnitude = static_cast<unsigned long long>(number);
   if (number < 0) {
     sign_ = -1;
-    number *= -1;
+    magnitude = 0ULL - magnitude;
   }
 
-  while (number) {
-    number_.push_back(number % 10);
-    number /= 10;
+  while (magnitude) {
+    number_.push_back(static_cast<int>(magnitude % 10));
+    magnitude /= 10;
   }
 
   details::removeZeros(number_);
@@ -92,6 +520,7 @@ BigInteger::BigInteger(int number) {
 }
 
 BigInteger::BigInteger(std::string number_str) {
+  LONG_ARITHMETIC_PROFILE_SCOPE(Operation::Parse, number_str.size());
   number_.reserve(number_str.size());
   std::reverse(std::begin(number_str), std::end(number_str));
   if (number_str.back() == '-') {
@@ -138,95 +567,88 @@ BigInteger BigInteger::operator--(int) {
 }
 
 BigInteger& BigInteger::operator-=(const BigInteger& rhs) {
-  auto tmp{rhs};
-  if (*this == tmp) {
-    number_.clear();
-    sign_ = 1;
-    return *this;
-  }
-
-  if (sign_ == tmp.sign_) {
-    auto current_sign = sign_;
-    sign_ = tmp.sign_ = 1;
-    if (tmp < *this) {
-      details::absSubstraction(number_, tmp.number_);
-      sign_ = (current_sign > 0 ? 1 : -1);
-    } else if (*this < tmp) {
-      details::absSubstraction(tmp.number_, number_);
-      number_ = tmp.number_;
-      sign_ = (current_sign > 0 ? -1 : 1);
-    }
-  } else {
-    tmp.sign_ *= -1;
-    *this += tmp;
-  }
-
-  details::removeZeros(number_);
+  LONG_ARITHMETIC_PROFILE_SCOPE(Operation::Subtract,
+                                std::max(limbCount(), rhs.limbCount()));
+  details::add(sign_, number_, -rhs.sign_, rhs.number_);
   return *this;
 }
 
 BigInteger& BigInteger::operator+=(const BigInteger& rhs) {
-  auto tmp{rhs};
-  if (sign_ == tmp.sign_) {
-    if (number_.size() < tmp.number_.size())
-      number_.resize(tmp.number_.size(), 0);
-
-    for (std::size_t i = 0; i != tmp.number_.size(); ++i) {
-      number_[i] += tmp.number_[i];
-    }
-
-    details::toBase10(number_);
-    details::removeZeros(number_);
-  } else {
-    tmp.sign_ *= -1;
-    *this -= tmp;
-  }
-
+  LONG_ARITHMETIC_PROFILE_SCOPE(Operation::Add,
+                                std::max(limbCount(), rhs.limbCount()));
+  details::add(sign_, number_, rhs.sign_, rhs.number_);
   return *this;
 }
 
 BigInteger& BigInteger::operator*=(const BigInteger& rhs) {
-  if (*this == 0)
+  LONG_ARITHMETIC_PROFILE_SCOPE(Operation::Multiply,
+                                std::max(limbCount(), rhs.limbCount()));
+  if (isZero())
     return *this;
 
-  if (rhs == 0) {
+  if (rhs.isZero()) {
     number_.clear();
     sign_ = 1;
     return *this;
   }
 
-  std::vector<int> accumulator(std::max(number_.size(), rhs.number_.size()) + 1);
-
-  for (std::size_t j = 0; j != rhs.number_.size(); ++j) {
-    for (std::size_t k = 0; k != number_.size(); ++k) {
-      auto element = number_[k] * rhs.number_[j];
-      accumulator[k + j] += element;
-    }
-  }
-
-  number_ = accumulator;
+  auto res = details::multiply(number_, rhs.number_);
+  details::scratchPool().release(number_);
+  number_ = std::move(res);
   sign_ *= rhs.sign_;
-  details::toBase10(number_);
-  details::removeZeros(number_);
   return *this;
 }
 
 BigInteger& BigInteger::operator/=(const BigInteger& rhs) {
-  if (!rhs)
-    throw std::runtime_error("division by zero");
-
-  number_ = details::devide(number_, rhs.number_);
-  details::removeZeros(number_);
-  number_.empty() ? sign_ = 1 : sign_ *= rhs.sign_;
+  LONG_ARITHMETIC_PROFILE_SCOPE(Operation::Divide,
+                                std::max(limbCount(), rhs.limbCount()));
+  details::divide(sign_, number_, rhs.sign_, rhs.number_);
   return *this;
 }
 
 BigInteger& BigInteger::operator%=(const BigInteger& rhs) {
-  if (!rhs)
-    throw std::runtime_error("Division by zero.");
+  LONG_ARITHMETIC_PROFILE_SCOPE(Operation::Remainder,
+                                std::max(limbCount(), rhs.limbCount()));
+  details::remainder(sign_, number_, rhs.number_);
+  return *this;
+}
+
+BigInteger& BigInteger::operator+=(const BigIntegerView& rhs) {
+  details::add(sign_, number_, rhs.sign() < 0 ? -1 : 1, rhs.limbs());
+  return *this;
+}
+
+BigInteger& BigInteger::operator-=(const BigIntegerView& rhs) {
+  details::add(sign_, number_, rhs.sign() < 0 ? 1 : -1, rhs.limbs());
+  return *this;
+}
+
+BigInteger& BigInteger::operator*=(const BigIntegerView& rhs) {
+  auto& pool = details::scratchPool();
+  auto view_limbs = rhs.limbs();
+  auto limbs = pool.acquire(std::begin(view_limbs), std::end(view_limbs));
+  auto res = details::multiply(number_, limbs);
+  pool.release(limbs);
+  pool.release(number_);
+  number_ = std::move(res);
+  number_.empty() ? sign_ = 1 : sign_ *= (rhs.sign() < 0 ? -1 : 1);
+  return *this;
+}
+
+BigInteger& BigInteger::operator/=(const BigIntegerView& rhs) {
+  details::divide(sign_, number_, rhs.sign() < 0 ? -1 : 1, rhs.limbs());
+  return *this;
+}
+
+BigInteger& BigInteger::operator%=(const BigIntegerView& rhs) {
+  details::remainder(sign_, number_, rhs.limbs());
+  return *this;
+}
+
+BigInteger& BigInteger::shiftLeft(std::size_t count) {
+  if (!number_.empty())
+    number_.insert(std::begin(number_), count, 0);
 
-  details::devide(number_, rhs.number_);
-  number_.empty() ? sign_ = 1 : sign_ *= rhs.sign_;
   return *this;
 }
 
@@ -235,6 +657,7 @@ BigInteger::operator bool() const {
 }
 
 std::string BigInteger::toString() const {
+  LONG_ARITHMETIC_PROFILE_SCOPE(Operation::ToString, limbCount());
   std::string tmp;
 
   for (auto&& item : number_) {
@@ -251,6 +674,96 @@ std::string BigInteger::toString() const {
   return tmp;
 }
 
+double BigInteger::toDouble() const {
+  return ratioToFloat<double>(*this, BigInteger{1});
+}
+
+long double BigInteger::toLongDouble() const {
+  return ratioToFloat<long double>(*this, BigInteger{1});
+}
+
+std::size_t BigInteger::limbCount() const noexcept {
+  return number_.size();
+}
+
+int BigInteger::sign() const noexcept {
+  return number_.empty() ? 0 : sign_;
+}
+
+bool BigInteger::isZero() const noexcept {
+  return number_.empty();
+}
+
+bool BigInteger::isOdd() const noexcept {
+  return !number_.empty() && number_.front() % 2;
+}
+
+bool BigInteger::isOne() const noexcept {
+  return number_.size() == 1 && number_.front() == 1 && sign_ > 0;
+}
+
+std::size_t BigInteger::digitCountEstimate() const noexcept {
+  return number_.empty() ? 1 : number_.size();
+}
+
+// the magnitude is built up from the top limb and checked against the
+// limit before each step, so it never overflows
+template <typename Integer>
+bool BigInteger::fits() const noexcept {
+  using Limits = std::numeric_limits<Integer>;
+  if (sign() < 0 && !Limits::is_signed)
+    return false;
+
+  auto limit = static_cast<unsigned long long>(Limits::max());
+  // the minimum of a two's complement type is one further from zero
+  if (sign() < 0)
+    ++limit;
+
+  unsigned long long magnitude{0};
+  for (auto it = number_.rbegin(); it != number_.rend(); ++it) {
+    auto digit = static_cast<unsigned long long>(*it);
+    if (magnitude > (limit - digit) / 10)
+      return false;
+
+    magnitude = magnitude * 10 + digit;
+  }
+
+  return true;
+}
+
+template <typename Integer>
+Integer BigInteger::to() const {
+  if (!fits<Integer>())
+    throw std::runtime_error("the number does not fit into the type");
+
+  unsigned long long magnitude{0};
+  for (auto it = number_.rbegin(); it != number_.rend(); ++it) {
+    magnitude = magnitude * 10 + static_cast<unsigned long long>(*it);
+  }
+
+  if (sign_ < 0)
+    magnitude = 0ULL - magnitude;
+
+  return static_cast<Integer>(magnitude);
+}
+
+template bool BigInteger::fits<int>() const noexcept;
+template bool BigInteger::fits<long>() const noexcept;
+template bool BigInteger::fits<long long>() const noexcept;
+template bool BigInteger::fits<unsigned>() const noexcept;
+template bool BigInteger::fits<unsigned long>() const noexcept;
+template bool BigInteger::fits<unsigned long long>() const noexcept;
+template int BigInteger::to<int>() const;
+template long BigInteger::to<long>() const;
+template long long BigInteger::to<long long>() const;
+template unsigned BigInteger::to<unsigned>() const;
+template unsigned long BigInteger::to<unsigned long>() const;
+template unsigned long long BigInteger::to<unsigned long long>() const;
+
+std::size_t BigInteger::hash() const noexcept {
+  return details::hashLimbs(sign_ < 0 && !number_.empty(), number_);
+}
+
 void BigInteger::swap(BigInteger& rhs) {
   using std::swap;
   swap(sign_, rhs.sign_);
@@ -265,16 +778,17 @@ bool BigInteger::compare(const BigInteger& rhs) const {
 }
 
 bool BigInteger::less(const BigInteger& rhs) const {
-    if (*this == rhs)
-      return false;
-
-    if (sign_ < rhs.sign_)
-      return true;
+  return (*this <=> rhs) < 0;
+}
 
-    if (rhs.sign_ < sign_)
-      return false;
+// one scan at most: signs and lengths decide before the limbs are read
+std::strong_ordering BigInteger::operator<=>(const BigInteger& rhs) const {
+  int lhs_sign = number_.empty() ? 0 : sign_;
+  int rhs_sign = rhs.number_.empty() ? 0 : rhs.sign_;
+  if (lhs_sign != rhs_sign)
+    return lhs_sign <=> rhs_sign;
 
-    return details::absCompare(number_, number_) * sign_ < 0;
+  return lhs_sign * details::absCompare(number_, rhs.number_) <=> 0;
 }
 
 BigInteger operator+(const BigInteger& lhs, const BigInteger& rhs) {
@@ -315,22 +829,6 @@ bool operator!=(const BigInteger& lhs, const BigInteger& rhs) {
   return !(lhs == rhs);
 }
 
-bool operator<(const BigInteger& lhs, const BigInteger& rhs) {
-  return lhs.less(rhs);
-}
-
-bool operator>(const BigInteger& lhs, const BigInteger& rhs) {
-  return rhs < lhs;
-}
-
-bool operator<=(const BigInteger& lhs, const BigInteger& rhs) {
-  return !(rhs < lhs);
-}
-
-bool operator>=(const BigInteger& lhs, const BigInteger& rhs) {
-  return !(lhs < rhs);
-}
-
 BigInteger operator""_bi(const char* str) {
   return BigInteger(static_cast<std::string>(str));
 }
@@ -353,15 +851,29 @@ void swap(BigInteger& lhs, BigInteger& rhs) {
 }
 
 BigInteger abs(const BigInteger& number) {
-  return (number < 0) ? -number : number;
+  return number.sign() < 0 ? -number : number;
 }
 
 BigInteger gcd(const BigInteger& lhs, const BigInteger& rhs) {
+  LONG_ARITHMETIC_PROFILE_SCOPE(Operation::Gcd,
+                                std::max(lhs.limbCount(), rhs.limbCount()));
   auto tmp_lhs = abs(lhs);
   auto tmp_rhs = abs(rhs);
-  while(tmp_rhs) {
+  if (tmp_lhs < tmp_rhs)
+    swap(tmp_lhs, tmp_rhs);
+
+  while (!tmp_rhs.isZero()) {
+    // the rest of Euclid runs on machine words
+    if (tmp_lhs.digitCountEstimate() <= details::kWordDigits &&
+        tmp_rhs.digitCountEstimate() <= details::kWordDigits) {
+      return static_cast<long long>(std::gcd(tmp_lhs.to<std::int64_t>(),
+                                             tmp_rhs.to<std::int64_t>()));
+    }
+
+    if (!details::lehmerStep(tmp_lhs.number_, tmp_rhs.number_)) {
       tmp_lhs %= tmp_rhs;
       swap(tmp_lhs, tmp_rhs);
+    }
   }
 
   return tmp_lhs;
@@ -370,3 +882,33 @@ BigInteger gcd(const BigInteger& lhs, const BigInteger& rhs) {
 BigInteger lcm(const BigInteger& lhs, const BigInteger& rhs) {
   return (lhs * rhs) / gcd(lhs, rhs);
 }
+
+BigInteger pow10(std::size_t exponent) {
+  BigInteger res{1};
+  return res.shiftLeft(exponent);
+}
+
+BigInteger pow2(std::size_t exponent) {
+  BigInteger res{1};
+  BigInteger base{2};
+  while (exponent) {
+    if (exponent % 2)
+      res *= base;
+
+    exponent /= 2;
+    if (exponent)
+      base *= base;
+  }
+
+  return res;
+}
+
+Thresholds thresholds() noexcept {
+  return {details::karatsuba_threshold.load(std::memory_order_relaxed)};
+}
+
+void setThresholds(const Thresholds& value) noexcept {
+  details::karatsuba_threshold.store(
+      std::max(value.karatsuba, details::kMinKaratsubaThreshold),
+      std::memory_order_relaxed);
+}
@@ -0,0 +1,128 @@
+#include "long_arithmetic/bigIntegerAccumulator.h"
+
+#include <climits>
+#include <cstddef>
+#include <vector>
+
+
+namespace details {
+
+// normalised limbs are within [-9, 9] and every term adds at most 9
+constexpr std::size_t kMaxPendingTerms{INT_MAX / 9 - 1};
+
+// propagates the carries with floor division, returns the final carry
+long long carryLimbs(std::vector<int>& limbs) {
+  long long carry{0};
+  for (auto&& item : limbs) {
+    carry += item;
+    auto digit = static_cast<int>(carry % 10);
+    carry /= 10;
+    if (digit < 0) {
+      digit += 10;
+      --carry;
+    }
+
+    item = digit;
+  }
+
+  for (; carry > 0; carry /= 10) {
+    limbs.push_back(static_cast<int>(carry % 10));
+  }
+
+  return carry;
+}
+
+} // namespace details //-----------------------------------------------//
+
+// BigIntegerAccumulator implementation //------------------------------//
+BigIntegerAccumulator::BigIntegerAccumulator(const BigInteger& value) {
+  *this += value;
+}
+
+template <typename Limbs>
+void BigIntegerAccumulator::add(int sign, const Limbs& limbs) {
+  if (pending_ == details::kMaxPendingTerms)
+    normalize();
+
+  if (limbs_.size() < limbs.size())
+    limbs_.resize(limbs.size(), 0);
+
+  for (std::size_t i = 0; i != limbs.size(); ++i) {
+    limbs_[i] += sign * limbs[i];
+  }
+
+  ++pending_;
+}
+
+BigIntegerAccumulator& BigIntegerAccumulator::operator+=(
+    const BigInteger& rhs) {
+  add(rhs.sign_, rhs.number_);
+  return *this;
+}
+
+BigIntegerAccumulator& BigIntegerAccumulator::operator-=(
+    const BigInteger& rhs) {
+  add(-rhs.sign_, rhs.number_);
+  return *this;
+}
+
+BigIntegerAccumulator& BigIntegerAccumulator::operator+=(
+    const BigIntegerView& rhs) {
+  add(rhs.sign() < 0 ? -1 : 1, rhs.limbs());
+  return *this;
+}
+
+BigIntegerAccumulator& BigIntegerAccumulator::operator-=(
+    const BigIntegerView& rhs) {
+  add(rhs.sign() < 0 ? 1 : -1, rhs.limbs());
+  return *this;
+}
+
+// afterwards every limb carries the sign of the whole value
+void BigIntegerAccumulator::normalize() {
+  pending_ = 0;
+  auto carry = details::carryLimbs(limbs_);
+  int sign{1};
+  if (carry < 0) {
+    // the value is negative: normalise its magnitude instead
+    sign = -1;
+    for (auto&& item : limbs_) {
+      item = -item;
+    }
+
+    for (carry = -carry; carry; carry /= 10) {
+      limbs_.push_back(static_cast<int>(carry % 10));
+    }
+
+    details::carryLimbs(limbs_);
+  }
+
+  while (!limbs_.empty() && limbs_.back() == 0) {
+    limbs_.pop_back();
+  }
+
+  if (sign < 0) {
+    for (auto&& item : limbs_) {
+      item = -item;
+    }
+  }
+}
+
+BigInteger BigIntegerAccumulator::value() {
+  normalize();
+  BigInteger res;
+  res.number_.reserve(limbs_.size());
+  for (auto&& item : limbs_) {
+    res.number_.push_back(item < 0 ? -item : item);
+  }
+
+  if (!limbs_.empty() && limbs_.back() < 0)
+    res.sign_ = -1;
+
+  return res;
+}
+
+void BigIntegerAccumulator::clear() noexcept {
+  limbs_.clear();
+  pending_ = 0;
+}
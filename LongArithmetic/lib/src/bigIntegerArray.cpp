@@ -0,0 +1,282 @@
+#include "long_arithmetic/bigIntegerArray.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <vector>
+
+
+namespace details {
+
+// the limb which continues a ten's complement number to the left
+std::int8_t signExtension(std::int8_t top) {
+  return top >= 5 ? 9 : 0;
+}
+
+std::size_t digitCount(unsigned long long number) {
+  std::size_t count{1};
+  for (; number >= 10; number /= 10) {
+    ++count;
+  }
+
+  return count;
+}
+
+} // namespace details //-----------------------------------------------//
+
+// BigIntegerArray implementation //------------------------------------//
+BigIntegerArray::BigIntegerArray(const std::vector<BigInteger>& values) {
+  reserve(values.size());
+  for (auto&& item : values) {
+    push_back(item);
+  }
+}
+
+std::int8_t* BigIntegerArray::row(std::size_t pos) {
+  return limbs_.data() + pos * capacity_;
+}
+
+const std::int8_t* BigIntegerArray::row(std::size_t pos) const {
+  return limbs_.data() + pos * capacity_;
+}
+
+// the number of top rows which only repeat the sign of every value
+std::size_t BigIntegerArray::headroom() const {
+  std::size_t count{0};
+  for (auto pos = width_ - 1; pos; --pos) {
+    const auto* top = row(pos);
+    const auto* next = row(pos - 1);
+    bool redundant = true;
+    for (std::size_t i = 0; i != size_; ++i) {
+      redundant &= top[i] == details::signExtension(next[i]);
+    }
+
+    if (!redundant)
+      break;
+
+    ++count;
+  }
+
+  return count;
+}
+
+void BigIntegerArray::relayout(std::size_t capacity, std::size_t width) {
+  std::vector<std::int8_t> limbs(capacity * width, 0);
+  for (std::size_t pos = 0; pos != width; ++pos) {
+    auto* dest = limbs.data() + pos * capacity;
+    const auto* src = row(std::min(pos, width_ - 1));
+    for (std::size_t i = 0; i != size_; ++i) {
+      dest[i] = pos < width_ ? src[i] : details::signExtension(src[i]);
+    }
+  }
+
+  limbs_.swap(limbs);
+  capacity_ = capacity;
+  width_ = width;
+}
+
+void BigIntegerArray::ensureHeadroom(std::size_t count) {
+  auto current = headroom();
+  if (current < count)
+    relayout(capacity_, width_ + count - current);
+}
+
+std::size_t BigIntegerArray::size() const noexcept {
+  return size_;
+}
+
+bool BigIntegerArray::empty() const noexcept {
+  return size_ == 0;
+}
+
+std::size_t BigIntegerArray::width() const noexcept {
+  return width_;
+}
+
+void BigIntegerArray::reserve(std::size_t capacity) {
+  if (capacity > capacity_)
+    relayout(capacity, width_);
+}
+
+void BigIntegerArray::push_back(const BigInteger& value) {
+  if (size_ == capacity_)
+    relayout(std::max<std::size_t>(1, 2 * capacity_), width_);
+
+  ++size_;
+  set(size_ - 1, value);
+}
+
+void BigIntegerArray::set(std::size_t index, const BigInteger& value) {
+  // one more limb keeps the sign of the value
+  if (value.number_.size() + 1 > width_)
+    relayout(capacity_, value.number_.size() + 1);
+
+  bool negative = value.sign_ < 0;
+  int carry = negative ? 1 : 0;
+  for (std::size_t pos = 0; pos != width_; ++pos) {
+    int digit = pos < value.number_.size() ? value.number_[pos] : 0;
+    digit = (negative ? 9 - digit : digit) + carry;
+    carry = digit / 10;
+    row(pos)[index] = static_cast<std::int8_t>(digit % 10);
+  }
+}
+
+BigInteger BigIntegerArray::operator[](std::size_t index) const {
+  BigInteger res;
+  bool negative = row(width_ - 1)[index] >= 5;
+  int carry = negative ? 1 : 0;
+  res.number_.reserve(width_);
+  for (std::size_t pos = 0; pos != width_; ++pos) {
+    int digit = row(pos)[index];
+    digit = (negative ? 9 - digit : digit) + carry;
+    carry = digit / 10;
+    res.number_.push_back(digit % 10);
+  }
+
+  while (!res.number_.empty() && res.number_.back() == 0) {
+    res.number_.pop_back();
+  }
+
+  if (negative && !res.number_.empty())
+    res.sign_ = -1;
+
+  return res;
+}
+
+BigIntegerArray& BigIntegerArray::operator+=(const BigIntegerArray& rhs) {
+  if (size_ != rhs.size_)
+    throw std::runtime_error("arrays of different sizes");
+
+  // both operands fit into one limb less than the result
+  auto width = std::max(width_ - headroom(), rhs.width_ - rhs.headroom()) + 1;
+  if (width > width_)
+    relayout(capacity_, width);
+
+  std::vector<std::int8_t> extension(size_);
+  const auto* rhs_top = rhs.row(rhs.width_ - 1);
+  for (std::size_t i = 0; i != size_; ++i) {
+    extension[i] = details::signExtension(rhs_top[i]);
+  }
+
+  std::vector<std::int8_t> carry(size_, 0);
+  for (std::size_t pos = 0; pos != width_; ++pos) {
+    auto* lhs_row = row(pos);
+    const auto* rhs_row = pos < rhs.width_ ? rhs.row(pos) : extension.data();
+    for (std::size_t i = 0; i != size_; ++i) {
+      int digit = lhs_row[i] + rhs_row[i] + carry[i];
+      carry[i] = static_cast<std::int8_t>(digit >= 10);
+      lhs_row[i] = static_cast<std::int8_t>(digit - 10 * carry[i]);
+    }
+  }
+
+  return *this;
+}
+
+BigIntegerArray& BigIntegerArray::operator*=(int scalar) {
+  if (scalar == 0) {
+    std::fill(std::begin(limbs_), std::end(limbs_), 0);
+    return *this;
+  }
+
+  auto magnitude = static_cast<unsigned long long>(scalar);
+  if (scalar < 0)
+    magnitude = 0ULL - magnitude;
+
+  ensureHeadroom(details::digitCount(magnitude) + 1);
+
+  auto factor = static_cast<long long>(magnitude);
+  std::vector<long long> carry(size_, 0);
+  for (std::size_t pos = 0; pos != width_; ++pos) {
+    auto* current = row(pos);
+    for (std::size_t i = 0; i != size_; ++i) {
+      long long digit = current[i] * factor + carry[i];
+      carry[i] = digit / 10;
+      current[i] = static_cast<std::int8_t>(digit % 10);
+    }
+  }
+
+  if (scalar < 0) {
+    std::vector<std::int8_t> borrow(size_, 1);
+    for (std::size_t pos = 0; pos != width_; ++pos) {
+      auto* current = row(pos);
+      for (std::size_t i = 0; i != size_; ++i) {
+        int digit = 9 - current[i] + borrow[i];
+        borrow[i] = static_cast<std::int8_t>(digit >= 10);
+        current[i] = static_cast<std::int8_t>(digit - 10 * borrow[i]);
+      }
+    }
+  }
+
+  return *this;
+}
+
+std::vector<int> BigIntegerArray::compare(const BigIntegerArray& rhs) const {
+  if (size_ != rhs.size_)
+    throw std::runtime_error("arrays of different sizes");
+
+  auto width = std::max(width_, rhs.width_);
+  std::vector<int> res(size_, 0);
+  for (auto pos = width; pos--;) {
+    const auto* lhs_row = row(std::min(pos, width_ - 1));
+    const auto* rhs_row = rhs.row(std::min(pos, rhs.width_ - 1));
+    bool lhs_extended = pos >= width_;
+    bool rhs_extended = pos >= rhs.width_;
+    bool top = pos + 1 == width;
+    for (std::size_t i = 0; i != size_; ++i) {
+      int lhs_digit = lhs_extended ? details::signExtension(lhs_row[i])
+                                   : lhs_row[i];
+      int rhs_digit = rhs_extended ? details::signExtension(rhs_row[i])
+                                   : rhs_row[i];
+      // the top limb carries the sign of the value
+      if (top) {
+        lhs_digit -= lhs_digit >= 5 ? 10 : 0;
+        rhs_digit -= rhs_digit >= 5 ? 10 : 0;
+      }
+
+      int current = (lhs_digit > rhs_digit) - (lhs_digit < rhs_digit);
+      res[i] = res[i] ? res[i] : current;
+    }
+  }
+
+  return res;
+}
+
+BigInteger BigIntegerArray::sum() const {
+  // the sum of the complements exceeds the real sum by 10^width for
+  // every negative value
+  long long negative{0};
+  std::vector<long long> sums(width_, 0);
+  for (std::size_t pos = 0; pos != width_; ++pos) {
+    const auto* current = row(pos);
+    long long accumulator{0};
+    for (std::size_t i = 0; i != size_; ++i) {
+      accumulator += current[i];
+    }
+
+    sums[pos] = accumulator;
+  }
+
+  const auto* top = row(width_ - 1);
+  for (std::size_t i = 0; i != size_; ++i) {
+    negative += top[i] >= 5;
+  }
+
+  BigInteger res;
+  long long carry{0};
+  for (std::size_t pos = 0; carry || pos < width_; ++pos) {
+    carry += pos < width_ ? sums[pos] : 0;
+    res.number_.push_back(static_cast<int>(carry % 10));
+    carry /= 10;
+  }
+
+  while (!res.number_.empty() && res.number_.back() == 0) {
+    res.number_.pop_back();
+  }
+
+  BigInteger overflow{negative};
+  if (overflow)
+    overflow.number_.insert(std::begin(overflow.number_), width_, 0);
+
+  return res - overflow;
+}
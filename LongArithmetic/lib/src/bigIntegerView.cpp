@@ -0,0 +1,385 @@
+#include "long_arithmetic/bigIntegerView.h"
+#include "limbHash.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <string>
+
+#if __has_include(<sys/mman.h>)
+#define LONG_ARITHMETIC_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#include <iterator>
+#endif
+
+
+namespace details {
+
+template <typename Lhs, typename Rhs>
+int compareLimbs(int lhs_sign, const Lhs& lhs, int rhs_sign, const Rhs& rhs) {
+  lhs_sign = lhs.empty() ? 0 : lhs_sign;
+  rhs_sign = rhs.empty() ? 0 : rhs_sign;
+  if (lhs_sign != rhs_sign)
+    return lhs_sign < rhs_sign ? -1 : 1;
+
+  if (lhs.size() != rhs.size())
+    return lhs.size() < rhs.size() ? -lhs_sign : lhs_sign;
+
+  for (std::size_t i = lhs.size(); i--;) {
+    if (lhs[i] != rhs[i])
+      return lhs[i] < rhs[i] ? -lhs_sign : lhs_sign;
+  }
+
+  return 0;
+}
+
+// every nibble is a decimal digit, and the padding nibble of an odd count
+// is zero
+bool validDigits(const unsigned char* data, std::uint64_t count) {
+  for (std::uint64_t i = 0; i != count / 2; ++i) {
+    if ((data[i] & 0x0f) > 9 || data[i] >> 4 > 9)
+      return false;
+  }
+
+  return count % 2 == 0 || data[count / 2] <= 9;
+}
+
+} // namespace details //-----------------------------------------------//
+
+// PackedDigits implementation //---------------------------------------//
+PackedDigits::Iterator::Iterator(const unsigned char* data, std::size_t pos)
+    : data_{data}, pos_{pos} {
+}
+
+PackedDigits::Iterator::reference
+PackedDigits::Iterator::operator*() const noexcept {
+  return (data_[pos_ / 2] >> (4 * (pos_ % 2))) & 0x0f;
+}
+
+PackedDigits::Iterator& PackedDigits::Iterator::operator++() noexcept {
+  ++pos_;
+  return *this;
+}
+
+PackedDigits::Iterator PackedDigits::Iterator::operator++(int) noexcept {
+  auto tmp{*this};
+  ++pos_;
+  return tmp;
+}
+
+bool PackedDigits::Iterator::operator==(const Iterator& rhs) const noexcept {
+  return pos_ == rhs.pos_;
+}
+
+bool PackedDigits::Iterator::operator!=(const Iterator& rhs) const noexcept {
+  return !(*this == rhs);
+}
+
+PackedDigits::PackedDigits(const unsigned char* data, std::size_t size)
+    : data_{data}, size_{size} {
+}
+
+std::size_t PackedDigits::size() const noexcept {
+  return size_;
+}
+
+bool PackedDigits::empty() const noexcept {
+  return size_ == 0;
+}
+
+PackedDigits::Iterator PackedDigits::begin() const noexcept {
+  return Iterator{data_, 0};
+}
+
+PackedDigits::Iterator PackedDigits::end() const noexcept {
+  return Iterator{data_, size_};
+}
+
+// BigIntegerView implementation //-------------------------------------//
+BigIntegerView::BigIntegerView(int sign, PackedDigits limbs)
+    : sign_{sign < 0 && !limbs.empty() ? -1 : 1}, limbs_{limbs} {
+}
+
+int BigIntegerView::sign() const noexcept {
+  return limbs_.empty() ? 0 : sign_;
+}
+
+PackedDigits BigIntegerView::limbs() const noexcept {
+  return limbs_;
+}
+
+BigInteger BigIntegerView::toBigInteger() const {
+  BigInteger res;
+  res.number_.assign(std::begin(limbs_), std::end(limbs_));
+  res.sign_ = sign_;
+  return res;
+}
+
+std::string BigIntegerView::toString() const {
+  if (limbs_.empty())
+    return "0";
+
+  std::string res{};
+  res.reserve(limbs_.size() + 1);
+  if (sign_ < 0)
+    res.push_back('-');
+
+  for (auto i = limbs_.size(); i--;) {
+    res.push_back(static_cast<char>(limbs_[i] + '0'));
+  }
+
+  return res;
+}
+
+int BigIntegerView::compare(const BigIntegerView& rhs) const {
+  return details::compareLimbs(sign_, limbs_, rhs.sign_, rhs.limbs_);
+}
+
+int BigIntegerView::compare(const BigInteger& rhs) const {
+  return details::compareLimbs(sign_, limbs_, rhs.sign_, rhs.number_);
+}
+
+std::size_t BigIntegerView::hash() const noexcept {
+  return details::hashLimbs(sign() < 0, limbs_);
+}
+
+bool operator==(const BigIntegerView& lhs, const BigIntegerView& rhs) {
+  return lhs.compare(rhs) == 0;
+}
+
+bool operator!=(const BigIntegerView& lhs, const BigIntegerView& rhs) {
+  return !(lhs == rhs);
+}
+
+bool operator<(const BigIntegerView& lhs, const BigIntegerView& rhs) {
+  return lhs.compare(rhs) < 0;
+}
+
+bool operator>(const BigIntegerView& lhs, const BigIntegerView& rhs) {
+  return rhs < lhs;
+}
+
+bool operator<=(const BigIntegerView& lhs, const BigIntegerView& rhs) {
+  return !(rhs < lhs);
+}
+
+bool operator>=(const BigIntegerView& lhs, const BigIntegerView& rhs) {
+  return !(lhs < rhs);
+}
+
+bool operator==(const BigIntegerView& lhs, const BigInteger& rhs) {
+  return lhs.compare(rhs) == 0;
+}
+
+bool operator!=(const BigIntegerView& lhs, const BigInteger& rhs) {
+  return !(lhs == rhs);
+}
+
+bool operator<(const BigIntegerView& lhs, const BigInteger& rhs) {
+  return lhs.compare(rhs) < 0;
+}
+
+bool operator>(const BigIntegerView& lhs, const BigInteger& rhs) {
+  return lhs.compare(rhs) > 0;
+}
+
+bool operator<=(const BigIntegerView& lhs, const BigInteger& rhs) {
+  return !(lhs > rhs);
+}
+
+bool operator>=(const BigIntegerView& lhs, const BigInteger& rhs) {
+  return !(lhs < rhs);
+}
+
+bool operator==(const BigInteger& lhs, const BigIntegerView& rhs) {
+  return rhs == lhs;
+}
+
+bool operator!=(const BigInteger& lhs, const BigIntegerView& rhs) {
+  return rhs != lhs;
+}
+
+bool operator<(const BigInteger& lhs, const BigIntegerView& rhs) {
+  return rhs > lhs;
+}
+
+bool operator>(const BigInteger& lhs, const BigIntegerView& rhs) {
+  return rhs < lhs;
+}
+
+bool operator<=(const BigInteger& lhs, const BigIntegerView& rhs) {
+  return rhs >= lhs;
+}
+
+bool operator>=(const BigInteger& lhs, const BigIntegerView& rhs) {
+  return rhs <= lhs;
+}
+
+BigInteger operator+(const BigInteger& lhs, const BigIntegerView& rhs) {
+  BigInteger tmp{lhs};
+  tmp += rhs;
+  return tmp;
+}
+
+BigInteger operator-(const BigInteger& lhs, const BigIntegerView& rhs) {
+  BigInteger tmp{lhs};
+  tmp -= rhs;
+  return tmp;
+}
+
+BigInteger operator*(const BigInteger& lhs, const BigIntegerView& rhs) {
+  BigInteger tmp{lhs};
+  tmp *= rhs;
+  return tmp;
+}
+
+BigInteger operator/(const BigInteger& lhs, const BigIntegerView& rhs) {
+  BigInteger tmp{lhs};
+  tmp /= rhs;
+  return tmp;
+}
+
+BigInteger operator%(const BigInteger& lhs, const BigIntegerView& rhs) {
+  BigInteger tmp{lhs};
+  tmp %= rhs;
+  return tmp;
+}
+
+std::ostream& operator<<(std::ostream& out, const BigIntegerView& rhs) {
+  out << rhs.toString();
+  return out;
+}
+
+// MappedBigIntegers implementation //----------------------------------//
+MappedBigIntegers::Iterator::Iterator(const unsigned char* pos,
+                                      const unsigned char* end)
+    : pos_{pos}, end_{end} {
+  parse();
+}
+
+// the header is checked on every step, the limbs are trusted to be digits
+void MappedBigIntegers::Iterator::parse() {
+  if (pos_ == end_) {
+    next_ = end_;
+    current_ = BigIntegerView{};
+    return;
+  }
+
+  constexpr std::size_t kHeaderSize{9};
+  if (static_cast<std::size_t>(end_ - pos_) < kHeaderSize)
+    throw std::runtime_error("truncated binary number");
+
+  auto sign = pos_[0];
+  std::uint64_t count{0};
+  for (std::size_t i = 0; i != 8; ++i) {
+    count |= static_cast<std::uint64_t>(pos_[1 + i]) << (8 * i);
+  }
+
+  const auto* data = pos_ + kHeaderSize;
+  auto bytes = count / 2 + count % 2;
+  if (bytes > static_cast<std::uint64_t>(end_ - data))
+    throw std::runtime_error("truncated binary number");
+
+  // the same canonical form BinaryReader accepts, so a view never holds
+  // a digit above nine or a leading zero
+  PackedDigits limbs{data, count};
+  if (sign > 1 || (count && limbs[count - 1] == 0) || (!count && sign) ||
+      !details::validDigits(data, count))
+    throw std::runtime_error("malformed binary number");
+
+  current_ = BigIntegerView{sign ? -1 : 1, limbs};
+  next_ = data + bytes;
+}
+
+MappedBigIntegers::Iterator::reference
+MappedBigIntegers::Iterator::operator*() const {
+  return current_;
+}
+
+MappedBigIntegers::Iterator::pointer
+MappedBigIntegers::Iterator::operator->() const {
+  return &current_;
+}
+
+MappedBigIntegers::Iterator& MappedBigIntegers::Iterator::operator++() {
+  pos_ = next_;
+  parse();
+  return *this;
+}
+
+MappedBigIntegers::Iterator MappedBigIntegers::Iterator::operator++(int) {
+  auto tmp{*this};
+  ++(*this);
+  return tmp;
+}
+
+bool MappedBigIntegers::Iterator::operator==(const Iterator& rhs) const {
+  return pos_ == rhs.pos_;
+}
+
+bool MappedBigIntegers::Iterator::operator!=(const Iterator& rhs) const {
+  return !(*this == rhs);
+}
+
+#ifdef LONG_ARITHMETIC_MMAP
+MappedBigIntegers::MappedBigIntegers(const std::string& path) {
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0)
+    throw std::runtime_error("cannot open " + path);
+
+  struct stat info{};
+  if (::fstat(fd, &info) != 0) {
+    ::close(fd);
+    throw std::runtime_error("cannot stat " + path);
+  }
+
+  size_ = static_cast<std::size_t>(info.st_size);
+  if (size_) {
+    void* data = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED) {
+      ::close(fd);
+      throw std::runtime_error("cannot map " + path);
+    }
+
+    ::madvise(data, size_, MADV_SEQUENTIAL);
+    data_ = static_cast<const unsigned char*>(data);
+  }
+
+  ::close(fd);
+}
+
+MappedBigIntegers::~MappedBigIntegers() {
+  if (data_)
+    ::munmap(const_cast<unsigned char*>(data_), size_);
+}
+#else
+MappedBigIntegers::MappedBigIntegers(const std::string& path) {
+  std::ifstream in{path, std::ios::binary};
+  if (!in)
+    throw std::runtime_error("cannot open " + path);
+
+  buffer_.assign(std::istreambuf_iterator<char>{in},
+                 std::istreambuf_iterator<char>{});
+  if (in.bad())
+    throw std::runtime_error("cannot read " + path);
+
+  data_ = buffer_.data();
+  size_ = buffer_.size();
+}
+
+MappedBigIntegers::~MappedBigIntegers() = default;
+#endif
+
+MappedBigIntegers::Iterator MappedBigIntegers::begin() const {
+  return Iterator{data_, data_ + size_};
+}
+
+MappedBigIntegers::Iterator MappedBigIntegers::end() const {
+  return Iterator{data_ + size_, data_ + size_};
+}
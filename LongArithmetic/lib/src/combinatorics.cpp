@@ -0,0 +1,168 @@
+#include "long_arithmetic/combinatorics.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+namespace details {
+
+std::vector<std::uint64_t> primes(std::uint64_t limit) {
+  std::vector<std::uint64_t> res{};
+  if (limit < 2)
+    return res;
+
+  std::vector<bool> is_composite(limit + 1, false);
+  for (std::uint64_t i = 2; i <= limit; ++i) {
+    if (is_composite[i])
+      continue;
+
+    res.push_back(i);
+    if (i > limit / i)
+      continue;
+
+    for (std::uint64_t j = i * i; j <= limit; j += i) {
+      is_composite[j] = true;
+    }
+  }
+
+  return res;
+}
+
+// packs prime powers into machine words, so the product tree gets
+// a few large leaves instead of many tiny ones
+class FactorCollector {
+private:
+  static constexpr std::uint64_t kWordLimit =
+      std::numeric_limits<long long>::max();
+
+  std::uint64_t word_{1};
+  std::vector<BigInteger> factors_{};
+
+public:
+  void push(std::uint64_t prime, std::uint64_t exponent) {
+    for (; exponent; --exponent) {
+      if (word_ > kWordLimit / prime) {
+        factors_.emplace_back(static_cast<long long>(word_));
+        word_ = 1;
+      }
+
+      word_ *= prime;
+    }
+  }
+
+  // factors beyond a signed word go into the tree on their own
+  void push(std::uint64_t factor) {
+    if (factor > kWordLimit) {
+      factors_.emplace_back(std::to_string(factor));
+      return;
+    }
+
+    push(factor, 1);
+  }
+
+  BigInteger product() {
+    if (word_ > 1) {
+      factors_.emplace_back(static_cast<long long>(word_));
+      word_ = 1;
+    }
+
+    return ::product(std::move(factors_));
+  }
+};
+
+BigInteger swing(std::uint64_t n, const std::vector<std::uint64_t>& primes) {
+  FactorCollector collector;
+  for (auto&& prime : primes) {
+    if (prime > n)
+      break;
+
+    std::uint64_t exponent{0};
+    for (auto quotient = n / prime; quotient; quotient /= prime) {
+      exponent += quotient & 1;
+    }
+
+    collector.push(prime, exponent);
+  }
+
+  return collector.product();
+}
+
+BigInteger factorial(std::uint64_t n,
+                     const std::vector<std::uint64_t>& primes) {
+  // 20! is the largest factorial which fits into a signed machine word
+  if (n <= 20) {
+    long long res{1};
+    for (long long i = 2; i <= static_cast<long long>(n); ++i) {
+      res *= i;
+    }
+
+    return res;
+  }
+
+  auto half = factorial(n / 2, primes);
+  return half * half * swing(n, primes);
+}
+
+} // namespace details //-----------------------------------------------//
+
+BigInteger product(std::vector<BigInteger> factors) {
+  if (factors.empty())
+    return 1;
+
+  while (factors.size() > 1) {
+    std::size_t count{0};
+    for (std::size_t i = 0; i + 1 < factors.size(); i += 2) {
+      factors[count++] = factors[i] * factors[i + 1];
+    }
+
+    if (factors.size() % 2)
+      factors[count++] = std::move(factors.back());
+
+    factors.resize(count);
+  }
+
+  return factors.front();
+}
+
+BigInteger factorial(std::uint64_t n) {
+  return details::factorial(n, details::primes(n));
+}
+
+BigInteger binomial(std::uint64_t n, std::uint64_t k) {
+  if (k > n)
+    return 0;
+
+  k = std::min(k, n - k);
+  // far from the centre the falling product n * ... * (n - k + 1) is cheap,
+  // while the sieve below would need n entries
+  auto log_n = std::max<std::uint64_t>(std::bit_width(n), 1);
+  if (k < n / log_n) {
+    details::FactorCollector collector;
+    for (std::uint64_t i = 0; i != k; ++i) {
+      collector.push(n - i);
+    }
+
+    return collector.product() / factorial(k);
+  }
+
+  details::FactorCollector collector;
+  for (auto&& prime : details::primes(n)) {
+    // Legendre's formula for n! / (k! * (n - k)!)
+    std::uint64_t exponent{0};
+    for (std::uint64_t power = prime; ; power *= prime) {
+      exponent += n / power - k / power - (n - k) / power;
+      if (power > n / prime)
+        break;
+    }
+
+    collector.push(prime, exponent);
+  }
+
+  return collector.product();
+}
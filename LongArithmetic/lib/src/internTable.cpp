@@ -0,0 +1,55 @@
+#include "long_arithmetic/internTable.h"
+
+#include <cstddef>
+#include <utility>
+
+
+// InternTable implementation //----------------------------------------//
+std::size_t InternTable::Hash::operator()(
+    const BigInteger& value) const noexcept {
+  return value.hash();
+}
+
+std::size_t InternTable::Hash::operator()(
+    const BigIntegerView& value) const noexcept {
+  return value.hash();
+}
+
+bool InternTable::Equal::operator()(const BigInteger& lhs,
+                                    const BigInteger& rhs) const {
+  return lhs == rhs;
+}
+
+bool InternTable::Equal::operator()(const BigIntegerView& lhs,
+                                    const BigInteger& rhs) const {
+  return lhs == rhs;
+}
+
+bool InternTable::Equal::operator()(const BigInteger& lhs,
+                                    const BigIntegerView& rhs) const {
+  return rhs == lhs;
+}
+
+const BigInteger& InternTable::intern(const BigInteger& value) {
+  return *values_.insert(value).first;
+}
+
+const BigInteger& InternTable::intern(BigInteger&& value) {
+  return *values_.insert(std::move(value)).first;
+}
+
+const BigInteger& InternTable::intern(const BigIntegerView& value) {
+  auto it = values_.find(value);
+  if (it != values_.end())
+    return *it;
+
+  return *values_.insert(value.toBigInteger()).first;
+}
+
+std::size_t InternTable::size() const noexcept {
+  return values_.size();
+}
+
+void InternTable::clear() noexcept {
+  values_.clear();
+}
@@ -0,0 +1,143 @@
+#include "long_arithmetic/lazyRational.h"
+
+#include <algorithm>
+#include <compare>
+#include <exception>
+
+
+// LazyRational implementation //---------------------------------------//
+LazyRational::LazyRational(const Rational& value, std::size_t threshold)
+    : num_{value.numerator()}, demon_{value.denominator()},
+      threshold_{threshold}, trigger_{threshold} {
+}
+
+std::size_t LazyRational::threshold() const noexcept {
+  return threshold_;
+}
+
+void LazyRational::setThreshold(std::size_t threshold) {
+  threshold_ = threshold;
+  trigger_ = threshold;
+  reduceIfLarge();
+}
+
+std::size_t LazyRational::limbCount() const noexcept {
+  return num_.limbCount() + demon_.limbCount();
+}
+
+// a value that stays large after a reduction is not reduced again until
+// it doubles, so the gcds cost about as much as the operations themselves
+void LazyRational::reduceIfLarge() {
+  if (limbCount() > trigger_)
+    reduce();
+}
+
+LazyRational& LazyRational::operator+=(const LazyRational& rhs) {
+  // a common denominator needs no multiplication at all, otherwise the
+  // fractions are cross-multiplied and the gcds left to reduceIfLarge
+  if (demon_ == rhs.demon_) {
+    num_ += rhs.num_;
+  } else {
+    num_ *= rhs.demon_;
+    num_ += rhs.num_ * demon_;
+    demon_ *= rhs.demon_;
+  }
+
+  reduceIfLarge();
+  return *this;
+}
+
+LazyRational& LazyRational::operator-=(const LazyRational& rhs) {
+  if (demon_ == rhs.demon_) {
+    num_ -= rhs.num_;
+  } else {
+    num_ *= rhs.demon_;
+    num_ -= rhs.num_ * demon_;
+    demon_ *= rhs.demon_;
+  }
+
+  reduceIfLarge();
+  return *this;
+}
+
+LazyRational& LazyRational::operator*=(const LazyRational& rhs) {
+  num_ *= rhs.num_;
+  demon_ *= rhs.demon_;
+  reduceIfLarge();
+  return *this;
+}
+
+LazyRational& LazyRational::operator/=(const LazyRational& rhs) {
+  if (!rhs.num_)
+    throw std::runtime_error("division by zero");
+
+  num_ *= rhs.demon_;
+  demon_ *= rhs.num_;
+  if (demon_.sign() < 0) {
+    num_ = -num_;
+    demon_ = -demon_;
+  }
+
+  reduceIfLarge();
+  return *this;
+}
+
+void LazyRational::reduce() {
+  auto tmp_gcd = gcd(num_, demon_);
+  if (!tmp_gcd.isOne()) {
+    num_ /= tmp_gcd;
+    demon_ /= tmp_gcd;
+  }
+
+  trigger_ = std::max(threshold_, 2 * limbCount());
+}
+
+Rational LazyRational::value() const {
+  return Rational{num_, demon_};
+}
+
+std::string LazyRational::toString() const {
+  return value().toString();
+}
+
+// the denominators are positive, so the cross products keep the order
+std::strong_ordering LazyRational::operator<=>(
+    const LazyRational& rhs) const {
+  if (demon_ == rhs.demon_)
+    return num_ <=> rhs.num_;
+
+  return num_ * rhs.demon_ <=> rhs.num_ * demon_;
+}
+
+bool LazyRational::operator==(const LazyRational& rhs) const {
+  return (*this <=> rhs) == 0;
+}
+
+LazyRational operator+(const LazyRational& lhs, const LazyRational& rhs) {
+  auto tmp{lhs};
+  tmp += rhs;
+  return tmp;
+}
+
+LazyRational operator-(const LazyRational& lhs, const LazyRational& rhs) {
+  auto tmp{lhs};
+  tmp -= rhs;
+  return tmp;
+}
+
+LazyRational operator*(const LazyRational& lhs, const LazyRational& rhs) {
+  auto tmp{lhs};
+  tmp *= rhs;
+  return tmp;
+}
+
+LazyRational operator/(const LazyRational& lhs, const LazyRational& rhs) {
+  auto tmp{lhs};
+  tmp /= rhs;
+  return tmp;
+}
+
+std::ostream& operator<<(std::ostream& out, const LazyRational& rhs) {
+  out << rhs.toString();
+  return out;
+}
@@ -0,0 +1,59 @@
+#pragma once
+#ifndef LIMBHASH_H_
+#define LIMBHASH_H_
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace details {
+
+// 64x64 -> 128 bit multiplication folded back to 64 bits
+inline std::uint64_t mixHash(std::uint64_t lhs, std::uint64_t rhs) {
+  constexpr std::uint64_t kMask{0xffffffffULL};
+  std::uint64_t lhs_low = lhs & kMask, lhs_high = lhs >> 32;
+  std::uint64_t rhs_low = rhs & kMask, rhs_high = rhs >> 32;
+  std::uint64_t low_low = lhs_low * rhs_low;
+  std::uint64_t high_low = lhs_high * rhs_low;
+  std::uint64_t low_high = lhs_low * rhs_high;
+  std::uint64_t high_high = lhs_high * rhs_high;
+  std::uint64_t middle = (low_low >> 32) + (high_low & kMask) + low_high;
+  std::uint64_t low = (middle << 32) | (low_low & kMask);
+  std::uint64_t high = high_high + (high_low >> 32) + (middle >> 32);
+  return low ^ high;
+}
+
+// wyhash-like hash of decimal limbs: sixteen limbs are packed into one
+// word as nibbles and two words are mixed per step. BigInteger and
+// BigIntegerView share it, so equal values hash equally
+template <typename Limbs>
+std::size_t hashLimbs(bool negative, const Limbs& limbs) {
+  constexpr std::uint64_t kSecret[] = {
+      0xa0761d6478bd642fULL, 0xe7037ed1a0b428dbULL,
+      0x8ebc6af09c88c6e3ULL, 0x589965cc75374cc3ULL};
+
+  auto pack = [&limbs](std::size_t pos) {
+    std::uint64_t word{0};
+    for (std::size_t i = 0; i != 16 && pos + i < limbs.size(); ++i) {
+      word |= static_cast<std::uint64_t>(limbs[pos + i]) << (4 * i);
+    }
+
+    return word;
+  };
+
+  std::uint64_t seed = kSecret[0] ^ (negative ? kSecret[3] : 0);
+  std::size_t pos{0};
+  do {
+    auto lhs = pack(pos);
+    auto rhs = pack(pos + 16);
+    seed = mixHash(lhs ^ kSecret[1], rhs ^ seed);
+    pos += 32;
+  } while (pos < limbs.size());
+
+  return static_cast<std::size_t>(
+      mixHash(kSecret[2] ^ limbs.size(), seed ^ kSecret[1]));
+}
+
+} // namespace details //-----------------------------------------------//
+
+#endif // LIMBHASH_H_ //------------------------------------------------//
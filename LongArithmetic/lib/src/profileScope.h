@@ -0,0 +1,64 @@
+#pragma once
+#ifndef PROFILESCOPE_H_
+#define PROFILESCOPE_H_
+
+#include "long_arithmetic/profiling.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+
+namespace details {
+
+struct AtomicStats;
+
+// the counters of an operation in the calling thread, the first call of a
+// thread registers it and may allocate
+AtomicStats& threadStats(Operation operation);
+// adds an operation to the counters without allocating or locking
+void recordOperation(AtomicStats& stats, std::uint64_t nanoseconds,
+                     std::size_t limbs) noexcept;
+
+// times its own lifetime for the statistics and the installed hook. The
+// counters are looked up when the scope starts, so the destructor cannot
+// fail
+class ProfileScope {
+private:
+  ProfileHook hook_{profileHook()};
+  Operation operation_;
+  std::size_t limbs_;
+  AtomicStats& stats_;
+  std::chrono::steady_clock::time_point start_{};
+
+public:
+  ProfileScope(Operation operation, std::size_t limbs)
+      : operation_{operation}, limbs_{limbs},
+        stats_{threadStats(operation)},
+        start_{std::chrono::steady_clock::now()} {
+  }
+
+  ProfileScope(const ProfileScope&) = delete;
+  ProfileScope& operator=(const ProfileScope&) = delete;
+
+  ~ProfileScope() {
+    auto elapsed = std::chrono::steady_clock::now() - start_;
+    auto nanoseconds = static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    recordOperation(stats_, nanoseconds, limbs_);
+    if (hook_)
+      hook_(operation_, nanoseconds, limbs_);
+  }
+};
+
+} // namespace details //-----------------------------------------------//
+
+#ifdef LONG_ARITHMETIC_PROFILE
+#define LONG_ARITHMETIC_PROFILE_SCOPE(operation, limbs) \
+  details::ProfileScope profile_scope_{operation, limbs}
+#else
+#define LONG_ARITHMETIC_PROFILE_SCOPE(operation, limbs) \
+  static_cast<void>(0)
+#endif
+
+#endif // PROFILESCOPE_H_ //-------------------------------------------//
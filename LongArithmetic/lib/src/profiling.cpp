@@ -0,0 +1,196 @@
+#include "long_arithmetic/profiling.h"
+#include "profileScope.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <mutex>
+#include <vector>
+
+
+namespace details {
+
+std::atomic<ProfileHook> profile_hook{nullptr};
+
+struct AtomicStats {
+  std::atomic<std::uint64_t> count{0};
+  std::atomic<std::uint64_t> nanoseconds{0};
+  std::array<std::atomic<std::uint64_t>, kSizeBuckets> sizes{};
+};
+
+using StatsBlock = std::array<AtomicStats, kOperationCount>;
+
+// only the owning thread writes a counter, so a plain load and store is
+// enough and readers still see whole values
+void increment(std::atomic<std::uint64_t>& counter, std::uint64_t value) {
+  counter.store(counter.load(std::memory_order_relaxed) + value,
+                std::memory_order_relaxed);
+}
+
+// the blocks of the running threads, and the sums of the exited ones. The
+// mutex is taken when a thread starts or ends and by the readers, never
+// when an operation is recorded
+class StatsRegistry {
+private:
+  std::mutex mutex_{};
+  std::vector<StatsBlock*> blocks_{};
+  std::array<OperationStats, kOperationCount> retired_{};
+
+  static void addUp(std::array<OperationStats, kOperationCount>& res,
+                    const StatsBlock& block) {
+    for (std::size_t op = 0; op < kOperationCount; ++op) {
+      res[op].count += block[op].count.load(std::memory_order_relaxed);
+      res[op].nanoseconds +=
+          block[op].nanoseconds.load(std::memory_order_relaxed);
+      for (std::size_t i = 0; i < kSizeBuckets; ++i) {
+        res[op].sizes[i] += block[op].sizes[i].load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+public:
+  void add(StatsBlock* block) {
+    std::lock_guard lock{mutex_};
+    blocks_.push_back(block);
+  }
+
+  void remove(StatsBlock* block) {
+    std::lock_guard lock{mutex_};
+    addUp(retired_, *block);
+    blocks_.erase(std::find(blocks_.begin(), blocks_.end(), block));
+  }
+
+  std::array<OperationStats, kOperationCount> collect() {
+    std::lock_guard lock{mutex_};
+    auto res = retired_;
+    for (auto&& block : blocks_) {
+      addUp(res, *block);
+    }
+
+    return res;
+  }
+
+  // a thread recording meanwhile may keep a part of its counts
+  void reset() {
+    std::lock_guard lock{mutex_};
+    retired_ = {};
+    for (auto&& block : blocks_) {
+      for (auto&& stats : *block) {
+        stats.count.store(0, std::memory_order_relaxed);
+        stats.nanoseconds.store(0, std::memory_order_relaxed);
+        for (auto&& size : stats.sizes) {
+          size.store(0, std::memory_order_relaxed);
+        }
+      }
+    }
+  }
+};
+
+StatsRegistry& statsRegistry() {
+  static StatsRegistry registry{};
+  return registry;
+}
+
+class ThreadStats {
+private:
+  StatsBlock block_{};
+
+public:
+  ThreadStats() {
+    statsRegistry().add(&block_);
+  }
+
+  ThreadStats(const ThreadStats&) = delete;
+  ThreadStats& operator=(const ThreadStats&) = delete;
+
+  ~ThreadStats() {
+    statsRegistry().remove(&block_);
+  }
+
+  StatsBlock& block() noexcept {
+    return block_;
+  }
+};
+
+AtomicStats& threadStats(Operation operation) {
+  thread_local ThreadStats stats{};
+  return stats.block()[static_cast<std::size_t>(operation)];
+}
+
+void recordOperation(AtomicStats& stats, std::uint64_t nanoseconds,
+                     std::size_t limbs) noexcept {
+  auto bucket = std::min<std::size_t>(std::bit_width(limbs), kSizeBuckets - 1);
+  increment(stats.count, 1);
+  increment(stats.nanoseconds, nanoseconds);
+  increment(stats.sizes[bucket], 1);
+}
+
+} // namespace details //-----------------------------------------------//
+
+// Profiling implementation //------------------------------------------//
+void setProfileHook(ProfileHook hook) noexcept {
+  details::profile_hook.store(hook, std::memory_order_release);
+}
+
+ProfileHook profileHook() noexcept {
+  return details::profile_hook.load(std::memory_order_acquire);
+}
+
+const char* operationName(Operation operation) noexcept {
+  switch (operation) {
+    case Operation::Add:
+      return "add";
+    case Operation::Subtract:
+      return "subtract";
+    case Operation::Multiply:
+      return "multiply";
+    case Operation::Divide:
+      return "divide";
+    case Operation::Remainder:
+      return "remainder";
+    case Operation::Gcd:
+      return "gcd";
+    case Operation::ToString:
+      return "toString";
+    case Operation::Parse:
+      return "parse";
+  }
+
+  return "unknown";
+}
+
+std::array<OperationStats, kOperationCount> operationStats() {
+  return details::statsRegistry().collect();
+}
+
+void resetOperationStats() {
+  details::statsRegistry().reset();
+}
+
+// the histogram lists the limb ranges of the non-empty buckets
+void dumpOperationStats(std::ostream& out) {
+  auto stats = operationStats();
+  for (std::size_t op = 0; op < kOperationCount; ++op) {
+    if (!stats[op].count)
+      continue;
+
+    out << operationName(static_cast<Operation>(op))
+        << " count=" << stats[op].count
+        << " time_ns=" << stats[op].nanoseconds << " sizes=";
+    for (std::size_t i = 0; i < kSizeBuckets; ++i) {
+      if (!stats[op].sizes[i])
+        continue;
+
+      auto low = i ? std::size_t{1} << (i - 1) : 0;
+      out << "[" << low;
+      if (i + 1 == kSizeBuckets)
+        out << "+";
+      else if (i > 1)
+        out << "-" << (std::size_t{1} << i) - 1;
+
+      out << "]:" << stats[op].sizes[i] << " ";
+    }
+
+    out << "\n";
+  }
+}
@@ -1,135 +1,784 @@
 #include "long_arithmetic/rational.h"
 
 #include <algorithm>
+#include <bit>
+#include <cmath>
+#include <compare>
+#include <cstdlib>
 #include <exception>
+#include <limits>
+#include <utility>
 
 
 namespace details {
 
+// the divisions are skipped for coprime parts, and the signs are moved
+// without a multiplication
 void reduction(BigInteger& num, BigInteger& denom) {
+  if (num.isZero()) {
+    denom = 1;
+    return;
+  }
+
   BigInteger tmp_gcd = gcd(num, denom);
-  num /= tmp_gcd;
-  denom /= tmp_gcd;
+  if (!tmp_gcd.isOne()) {
+    num /= tmp_gcd;
+    denom /= tmp_gcd;
+  }
+
+  if (denom.sign() < 0) {
+    num = -num;
+    denom = -denom;
+  }
+}
+
+int signOf(const BigInteger& number) {
+  return number.sign();
+}
+
+int toInt(std::strong_ordering order) {
+  if (order < 0)
+    return -1;
+
+  return order > 0 ? 1 : 0;
+}
+
+// machine word arithmetic for the inline form. INT64_MIN is rejected as an
+// overflow too, so negating a word never overflows
+constexpr std::int64_t kWordMax{std::numeric_limits<std::int64_t>::max()};
+// every number with this many digits fits a word
+constexpr std::size_t kWordDigits{18};
+
+#ifdef __SIZEOF_INT128__
+__extension__ typedef __int128 Wide;
+
+bool checkedAdd(std::int64_t lhs, std::int64_t rhs, std::int64_t& result) {
+  auto wide = static_cast<Wide>(lhs) + rhs;
+  if (wide < -kWordMax || wide > kWordMax)
+    return false;
+
+  result = static_cast<std::int64_t>(wide);
+  return true;
+}
+
+bool checkedMultiply(std::int64_t lhs, std::int64_t rhs,
+                     std::int64_t& result) {
+  auto wide = static_cast<Wide>(lhs) * rhs;
+  if (wide < -kWordMax || wide > kWordMax)
+    return false;
+
+  result = static_cast<std::int64_t>(wide);
+  return true;
+}
+#else
+bool checkedAdd(std::int64_t lhs, std::int64_t rhs, std::int64_t& result) {
+  if (rhs > 0 ? lhs > kWordMax - rhs : lhs < -kWordMax - rhs)
+    return false;
+
+  result = lhs + rhs;
+  return true;
+}
+
+bool checkedMultiply(std::int64_t lhs, std::int64_t rhs,
+                     std::int64_t& result) {
+  if (lhs && rhs && std::abs(lhs) > kWordMax / std::abs(rhs))
+    return false;
+
+  result = lhs * rhs;
+  return true;
+}
+#endif
+
+// Stein's binary gcd, only shifts and subtractions
+std::int64_t binaryGcd(std::int64_t lhs, std::int64_t rhs) {
+  auto first = static_cast<std::uint64_t>(std::abs(lhs));
+  auto second = static_cast<std::uint64_t>(std::abs(rhs));
+  if (!first || !second)
+    return static_cast<std::int64_t>(first | second);
+
+  auto shift = std::countr_zero(first | second);
+  first >>= std::countr_zero(first);
+  do {
+    second >>= std::countr_zero(second);
+    if (first > second)
+      std::swap(first, second);
+
+    second -= first;
+  } while (second);
+
+  return static_cast<std::int64_t>(first << shift);
+}
+
+void smallReduction(std::int64_t& num, std::int64_t& denom) {
+  auto common = binaryGcd(num, denom);
+  num /= common;
+  denom /= common;
   if (denom < 0) {
-    num *= -1;
-    denom *= -1;
+    num = -num;
+    denom = -denom;
   }
 }
 
+// the word versions of addition and multiplication below, they leave the
+// operands untouched and return false on overflow
+bool smallAddition(std::int64_t& num, std::int64_t& denom,
+                   std::int64_t rhs_num, std::int64_t rhs_denom, int sign) {
+  auto common = binaryGcd(denom, rhs_denom);
+  auto lhs_part = denom / common;
+  std::int64_t lhs_term{};
+  std::int64_t rhs_term{};
+  std::int64_t sum{};
+  if (!checkedMultiply(num, rhs_denom / common, lhs_term) ||
+      !checkedMultiply(sign * rhs_num, lhs_part, rhs_term) ||
+      !checkedAdd(lhs_term, rhs_term, sum))
+    return false;
+
+  if (!sum) {
+    num = 0;
+    denom = 1;
+    return true;
+  }
+
+  auto rest = binaryGcd(sum, common);
+  std::int64_t res_denom{};
+  if (!checkedMultiply(lhs_part, rhs_denom / rest, res_denom))
+    return false;
+
+  num = sum / rest;
+  denom = res_denom;
+  return true;
+}
+
+bool smallMultiplication(std::int64_t& num, std::int64_t& denom,
+                         std::int64_t rhs_num, std::int64_t rhs_denom) {
+  if (!num || !rhs_num) {
+    num = 0;
+    denom = 1;
+    return true;
+  }
+
+  auto lhs_gcd = binaryGcd(num, rhs_denom);
+  auto rhs_gcd = binaryGcd(rhs_num, denom);
+  std::int64_t res_num{};
+  std::int64_t res_denom{};
+  if (!checkedMultiply(num / lhs_gcd, rhs_num / rhs_gcd, res_num) ||
+      !checkedMultiply(denom / rhs_gcd, rhs_denom / lhs_gcd, res_denom))
+    return false;
+
+  num = res_denom < 0 ? -res_num : res_num;
+  denom = res_denom < 0 ? -res_denom : res_denom;
+  return true;
+}
+
+// Henrici's addition: with g = gcd(b, d) the sum a/b + c/d is
+// (a * d/g + c * b/g) / (b * d/g), and only gcd(numerator, g) is left
+// to cancel, so no gcd of the full products is needed
+void addition(BigInteger& num, BigInteger& denom,
+              const BigInteger& rhs_num, const BigInteger& rhs_denom,
+              int sign) {
+  auto common = gcd(denom, rhs_denom);
+  auto lhs_part = common.isOne() ? denom : denom / common;
+  auto rhs_part = common.isOne() ? rhs_denom : rhs_denom / common;
+  auto other = rhs_num * lhs_part;
+  num *= rhs_part;
+  sign > 0 ? num += other : num -= other;
+  if (!num) {
+    denom = 1;
+    return;
+  }
+
+  auto rest = common.isOne() ? common : gcd(num, common);
+  if (rest.isOne()) {
+    denom = lhs_part * rhs_denom;
+    return;
+  }
+
+  num /= rest;
+  denom = lhs_part * (rhs_denom / rest);
+}
+
+// cross cancellation: a/b * c/d with gcd(a, d) and gcd(c, b) divided out
+// of the operands before the products, which are then already reduced
+void multiplication(BigInteger& num, BigInteger& denom,
+                    const BigInteger& rhs_num, const BigInteger& rhs_denom) {
+  if (!num || !rhs_num) {
+    num = 0;
+    denom = 1;
+    return;
+  }
+
+  auto lhs_gcd = gcd(num, rhs_denom);
+  auto rhs_gcd = gcd(rhs_num, denom);
+  auto res_num = (lhs_gcd.isOne() ? num : num / lhs_gcd) *
+                 (rhs_gcd.isOne() ? rhs_num : rhs_num / rhs_gcd);
+  auto res_denom = (rhs_gcd.isOne() ? denom : denom / rhs_gcd) *
+                   (lhs_gcd.isOne() ? rhs_denom : rhs_denom / lhs_gcd);
+  num = std::move(res_num);
+  denom = std::move(res_denom);
+  if (denom.sign() < 0) {
+    num = -num;
+    denom = -denom;
+  }
+}
+
+// a word converts to Float without rounding
+template <typename Float>
+bool exactIn(std::int64_t word) {
+  constexpr int kBits{std::min(std::numeric_limits<Float>::digits, 62)};
+  return std::abs(word) <= (std::int64_t{1} << kBits);
+}
+
+// a finite value is an odd mantissa times a power of two, a mantissa
+// above the long long range is built from its halves
+template <typename Float>
+Rational fromFloat(Float value) {
+  if (!std::isfinite(value))
+    throw std::runtime_error("the value is not finite");
+
+  if (std::fpclassify(value) == FP_ZERO)
+    return Rational{};
+
+  int exponent{};
+  auto fraction = std::frexp(std::fabs(value), &exponent);
+  constexpr int kDigits{std::numeric_limits<Float>::digits};
+  auto word = static_cast<std::uint64_t>(std::ldexp(fraction, kDigits));
+  auto zeros = std::countr_zero(word);
+  word >>= zeros;
+  exponent += zeros - kDigits;
+
+  BigInteger mantissa{static_cast<long long>(word / 2)};
+  mantissa *= 2;
+  mantissa += static_cast<long long>(word % 2);
+  if (value < 0)
+    mantissa = -mantissa;
+
+  if (exponent >= 0)
+    return Rational{mantissa * pow2(static_cast<std::size_t>(exponent))};
+
+  return Rational{mantissa, pow2(static_cast<std::size_t>(-exponent))};
+}
+
+bool isDigit(char symbol) {
+  return symbol >= '0' && symbol <= '9';
+}
+
+const char* skipDigits(const char* first, const char* last) {
+  while (first != last && isDigit(*first))
+    ++first;
+
+  return first;
+}
+
+std::int64_t toWord(std::string_view digits) {
+  std::int64_t word{0};
+  for (auto&& digit : digits) {
+    word = word * 10 + (digit - '0');
+  }
+
+  return word;
+}
+
+// digit count without the leading zeros of integer followed by fraction
+std::size_t significantDigits(std::string_view integer,
+                              std::string_view fraction) {
+  auto pos = integer.find_first_not_of('0');
+  if (pos != std::string_view::npos)
+    return integer.size() - pos + fraction.size();
+
+  pos = fraction.find_first_not_of('0');
+  return pos == std::string_view::npos ? 0 : fraction.size() - pos;
+}
+
+// floor of num / denom for a positive denom, rest gets the remainder
+BigInteger floorDivision(const BigInteger& num, const BigInteger& denom,
+                         BigInteger& rest) {
+  auto quotient = num / denom;
+  rest = num - quotient * denom;
+  if (rest.sign() < 0) {
+    --quotient;
+    rest += denom;
+  }
+
+  return quotient;
+}
+
+int compare(const BigInteger& num, const BigInteger& denom,
+            const BigInteger& rhs_num, const BigInteger& rhs_denom) {
+  // denominators are positive, so the numerators carry the signs
+  auto lhs_sign = signOf(num);
+  auto rhs_sign = signOf(rhs_num);
+  if (lhs_sign != rhs_sign)
+    return lhs_sign < rhs_sign ? -1 : 1;
+
+  if (!lhs_sign)
+    return 0;
+
+  if (denom == rhs_denom)
+    return toInt(num <=> rhs_num);
+
+  if (num == rhs_num)
+    return lhs_sign * toInt(rhs_denom <=> denom);
+
+  // |a / b| lies in (10^(la - lb - 1), 10^(la - lb + 1)) for la and lb
+  // digits, so scales two apart decide without any arithmetic
+  auto lhs_scale = static_cast<long long>(num.limbCount()) -
+                   static_cast<long long>(denom.limbCount());
+  auto rhs_scale = static_cast<long long>(rhs_num.limbCount()) -
+                   static_cast<long long>(rhs_denom.limbCount());
+  if (lhs_scale > rhs_scale + 1)
+    return lhs_sign;
+
+  if (rhs_scale > lhs_scale + 1)
+    return -lhs_sign;
+
+  auto lhs_int = num / denom;
+  auto rhs_int = rhs_num / rhs_denom;
+  if (lhs_int != rhs_int)
+    return toInt(lhs_int <=> rhs_int);
+
+  // equal integer parts, only the remainders need the cross products
+  auto lhs_rest = lhs_int ? num - lhs_int * denom : num;
+  auto rhs_rest = rhs_int ? rhs_num - rhs_int * rhs_denom : rhs_num;
+  lhs_rest *= rhs_denom;
+  rhs_rest *= denom;
+  return toInt(lhs_rest <=> rhs_rest);
+}
+
 } // namespace details //-----------------------------------------------//
 
 // Rational implementation //-------------------------------------------//
 Rational::Rational(const BigInteger& num, const BigInteger& denom)
-    : num_{num}, demon_{denom} {
+    : small_{false}, num_{num}, demon_{denom} {
+  if (!demon_)
+    throw std::runtime_error("the denominator is zero");
+
+  demote();
+  if (small_) {
+    details::smallReduction(small_num_, small_demon_);
+    return;
+  }
+
   details::reduction(num_, demon_);
+  demote();
 }
 
-Rational::Rational(const BigInteger& num) : num_{num}, demon_{1}
-{ }
+Rational::Rational(const BigInteger& num)
+    : small_{false}, num_{num}, demon_{1} {
+  demote();
+}
 
-Rational::Rational(int num) : num_{num}, demon_{1}
+Rational::Rational(int num) : small_num_{num}
 { }
 
+Rational Rational::fromDouble(double value) {
+  return details::fromFloat(value);
+}
+
+Rational Rational::fromLongDouble(long double value) {
+  return details::fromFloat(value);
+}
+
+std::int64_t Rational::toWord(const BigInteger& number) {
+  std::int64_t word{0};
+  for (auto it = number.number_.rbegin(); it != number.number_.rend(); ++it)
+    word = word * 10 + *it;
+
+  return number.sign_ * word;
+}
+
+const BigInteger& Rational::bigNumerator(BigInteger& storage) const {
+  if (!small_)
+    return num_;
+
+  storage = small_num_;
+  return storage;
+}
+
+const BigInteger& Rational::bigDenominator(BigInteger& storage) const {
+  if (!small_)
+    return demon_;
+
+  storage = small_demon_;
+  return storage;
+}
+
+void Rational::promote() {
+  if (!small_)
+    return;
+
+  num_ = small_num_;
+  demon_ = small_demon_;
+  small_ = false;
+}
+
+void Rational::demote() {
+  if (small_ || num_.limbCount() > details::kWordDigits ||
+      demon_.limbCount() > details::kWordDigits)
+    return;
+
+  small_num_ = toWord(num_);
+  small_demon_ = toWord(demon_);
+  num_ = BigInteger{};
+  demon_ = BigInteger{};
+  small_ = true;
+}
+
+// the limbs of number are reused, so a warm value does not allocate
+void Rational::assignDigits(BigInteger& number, bool negative,
+                            std::string_view integer,
+                            std::string_view fraction) {
+  auto& limbs = number.number_;
+  limbs.clear();
+  limbs.reserve(integer.size() + fraction.size());
+  for (auto it = fraction.rbegin(); it != fraction.rend(); ++it)
+    limbs.push_back(*it - '0');
+
+  for (auto it = integer.rbegin(); it != integer.rend(); ++it)
+    limbs.push_back(*it - '0');
+
+  while (!limbs.empty() && !limbs.back())
+    limbs.pop_back();
+
+  number.sign_ = negative && !limbs.empty() ? -1 : 1;
+}
+
+// integer.fraction or integer/denominator, an empty denominator means
+// 10^(fraction digits)
+void Rational::assign(bool negative, std::string_view integer,
+                      std::string_view fraction,
+                      std::string_view denominator) {
+  auto denom_digits = denominator.empty()
+                          ? fraction.size() + 1
+                          : details::significantDigits(denominator, {});
+  if (details::significantDigits(integer, fraction) <= details::kWordDigits &&
+      denom_digits <= details::kWordDigits) {
+    small_num_ = details::toWord(integer);
+    small_demon_ = 1;
+    for (auto&& digit : fraction) {
+      small_num_ = small_num_ * 10 + (digit - '0');
+      small_demon_ *= 10;
+    }
+
+    if (!denominator.empty())
+      small_demon_ = details::toWord(denominator);
+
+    if (negative)
+      small_num_ = -small_num_;
+
+    details::smallReduction(small_num_, small_demon_);
+    num_ = BigInteger{};
+    demon_ = BigInteger{};
+    small_ = true;
+    return;
+  }
+
+  assignDigits(num_, negative, integer, fraction);
+  if (denominator.empty())
+    demon_ = pow10(fraction.size());
+  else
+    assignDigits(demon_, false, denominator, {});
+
+  small_ = false;
+  details::reduction(num_, demon_);
+  demote();
+}
+
+BigInteger Rational::numerator() const {
+  return small_ ? BigInteger{small_num_} : num_;
+}
+
+BigInteger Rational::denominator() const {
+  return small_ ? BigInteger{small_demon_} : demon_;
+}
+
 Rational Rational::operator-() const {
   auto tmp{*this};
-  tmp *= -1;
+  if (tmp.small_)
+    tmp.small_num_ = -tmp.small_num_;
+  else
+    tmp.num_ = -tmp.num_;
+
   return tmp;
 }
 
 Rational& Rational::operator+=(const Rational& rhs) {
-  num_ = num_ * rhs.demon_ + rhs.num_ * demon_;
-  demon_ = demon_ * rhs.demon_;
-  details::reduction(num_, demon_);
+  if (small_ && rhs.small_ &&
+      details::smallAddition(small_num_, small_demon_, rhs.small_num_,
+                             rhs.small_demon_, 1))
+    return *this;
+
+  BigInteger num_storage{};
+  BigInteger denom_storage{};
+  const auto& rhs_num = rhs.bigNumerator(num_storage);
+  const auto& rhs_denom = rhs.bigDenominator(denom_storage);
+  promote();
+  details::addition(num_, demon_, rhs_num, rhs_denom, 1);
+  demote();
   return *this;
 }
 
 Rational& Rational::operator-=(const Rational& rhs) {
-  num_ = num_ * rhs.demon_ - rhs.num_ * demon_;
-  demon_ = demon_ * rhs.demon_;
-  details::reduction(num_, demon_);
+  if (small_ && rhs.small_ &&
+      details::smallAddition(small_num_, small_demon_, rhs.small_num_,
+                             rhs.small_demon_, -1))
+    return *this;
+
+  BigInteger num_storage{};
+  BigInteger denom_storage{};
+  const auto& rhs_num = rhs.bigNumerator(num_storage);
+  const auto& rhs_denom = rhs.bigDenominator(denom_storage);
+  promote();
+  details::addition(num_, demon_, rhs_num, rhs_denom, -1);
+  demote();
   return *this;
 }
 
 Rational& Rational::operator*=(const Rational& rhs) {
-  num_ *= rhs.num_;
-  demon_ *= rhs.demon_;
-  details::reduction(num_, demon_);
+  if (small_ && rhs.small_ &&
+      details::smallMultiplication(small_num_, small_demon_, rhs.small_num_,
+                                   rhs.small_demon_))
+    return *this;
+
+  BigInteger num_storage{};
+  BigInteger denom_storage{};
+  const auto& rhs_num = rhs.bigNumerator(num_storage);
+  const auto& rhs_denom = rhs.bigDenominator(denom_storage);
+  promote();
+  details::multiplication(num_, demon_, rhs_num, rhs_denom);
+  demote();
   return *this;
 }
 
 Rational& Rational::operator/=(const Rational& rhs) {
-  num_ *= rhs.demon_;
-  demon_ *= rhs.num_;
-  details::reduction(num_, demon_);
+  if (rhs.small_ ? !rhs.small_num_ : !rhs.num_)
+    throw std::runtime_error("division by zero");
+
+  if (small_ && rhs.small_ &&
+      details::smallMultiplication(small_num_, small_demon_,
+                                   rhs.small_demon_, rhs.small_num_))
+    return *this;
+
+  BigInteger num_storage{};
+  BigInteger denom_storage{};
+  const auto& rhs_num = rhs.bigNumerator(num_storage);
+  const auto& rhs_denom = rhs.bigDenominator(denom_storage);
+  promote();
+  details::multiplication(num_, demon_, rhs_denom, rhs_num);
+  demote();
   return *this;
 }
 
 
 std::string Rational::toString() const {
-  if (demon_ == 1)
+  if (small_ && small_demon_ == 1)
+    return std::to_string(small_num_);
+
+  if (small_)
+    return std::to_string(small_num_) + "/" + std::to_string(small_demon_);
+
+  if (demon_.isOne())
     return num_.toString();
 
   return num_.toString() + "/" + demon_.toString();
 }
 
-std::string Rational::asDecimal(std::size_t precision) const {
-  std::string res{};
-  Rational number{*this};
-  bool is_dot = false;
-  if (number < 0) {
-    res += '-';
-    number *= -1;
-    ++precision;
+// a single division of num * 10^precision by the denominator gives all
+// the digits, its remainder decides the rounding
+std::string Rational::asDecimal(std::size_t precision,
+                                RoundingMode rounding) const {
+  BigInteger num_storage{};
+  BigInteger denom_storage{};
+  const auto& num = bigNumerator(num_storage);
+  const auto& denom = bigDenominator(denom_storage);
+  auto scaled = abs(num);
+  scaled.shiftLeft(precision);
+  auto quotient = scaled / denom;
+  auto remainder = scaled - quotient * denom;
+  auto digits = quotient.toString();
+
+  bool negative = num.sign() < 0;
+  bool odd = (digits.back() - '0') % 2;
+  auto cmp = (remainder + remainder) <=> denom;
+  int half = cmp < 0 ? -1 : (cmp > 0 ? 1 : 0);
+  if (details::roundAway(rounding, negative, odd, half, !remainder)) {
+    ++quotient;
+    digits = quotient.toString();
   }
 
-  while (precision) {
-    BigInteger tmp = number.num_ / number.demon_;
-    number -= tmp;
-    number *= 10;
-    res += tmp.toString();
-    --precision;
+  if (digits.size() <= precision)
+    digits.insert(0, precision + 1 - digits.size(), '0');
 
-    if (!is_dot && precision) {
-      is_dot = true;
-      res += '.';
-    }
+  if (precision)
+    digits.insert(digits.size() - precision, 1, '.');
+
+  if (negative && quotient)
+    digits.insert(0, 1, '-');
+
+  return digits;
+}
+
+// both words exact in a double means the division rounds correctly
+double Rational::toDouble() const {
+  if (small_ && details::exactIn<double>(small_num_) &&
+      details::exactIn<double>(small_demon_))
+    return static_cast<double>(small_num_) /
+           static_cast<double>(small_demon_);
+
+  BigInteger num_storage{};
+  BigInteger denom_storage{};
+  return BigInteger::ratioToFloat<double>(bigNumerator(num_storage),
+                                          bigDenominator(denom_storage));
+}
+
+long double Rational::toLongDouble() const {
+  if (small_ && details::exactIn<long double>(small_num_) &&
+      details::exactIn<long double>(small_demon_))
+    return static_cast<long double>(small_num_) /
+           static_cast<long double>(small_demon_);
+
+  BigInteger num_storage{};
+  BigInteger denom_storage{};
+  return BigInteger::ratioToFloat<long double>(
+      bigNumerator(num_storage), bigDenominator(denom_storage));
+}
+
+std::vector<BigInteger> Rational::continuedFraction() const {
+  std::vector<BigInteger> terms{};
+  auto num = numerator();
+  auto denom = denominator();
+  BigInteger rest{};
+  while (denom) {
+    terms.push_back(details::floorDivision(num, denom, rest));
+    num.swap(denom);
+    denom.swap(rest);
   }
 
-  return res;
+  return terms;
+}
+
+// walks the convergents p/q until the next denominator exceeds the bound,
+// then picks the closer of the last convergent and the best semiconvergent
+Rational Rational::limitDenominator(const BigInteger& max_denominator) const {
+  if (max_denominator < 1)
+    throw std::runtime_error("the denominator bound is less than one");
+
+  auto num = numerator();
+  auto denom = denominator();
+  if (denom <= max_denominator)
+    return *this;
+
+  BigInteger prev_num{0};
+  BigInteger prev_denom{1};
+  BigInteger last_num{1};
+  BigInteger last_denom{0};
+  BigInteger rest{};
+  while (true) {
+    auto term = details::floorDivision(num, denom, rest);
+    auto next_denom = prev_denom + term * last_denom;
+    if (next_denom > max_denominator)
+      break;
+
+    auto next_num = prev_num + term * last_num;
+    prev_num.swap(last_num);
+    prev_denom.swap(last_denom);
+    last_num.swap(next_num);
+    last_denom.swap(next_denom);
+    num.swap(denom);
+    denom.swap(rest);
+  }
+
+  auto steps = (max_denominator - prev_denom) / last_denom;
+  Rational semiconvergent{prev_num + steps * last_num,
+                          prev_denom + steps * last_denom};
+  Rational convergent{last_num, last_denom};
+  auto semiconvergent_error = semiconvergent - *this;
+  auto convergent_error = convergent - *this;
+  if (semiconvergent_error < 0)
+    semiconvergent_error = -semiconvergent_error;
+
+  if (convergent_error < 0)
+    convergent_error = -convergent_error;
+
+  return convergent_error <= semiconvergent_error ? convergent
+                                                  : semiconvergent;
 }
 
 void Rational::swap(Rational& rhs) {
+  std::swap(small_num_, rhs.small_num_);
+  std::swap(small_demon_, rhs.small_demon_);
+  std::swap(small_, rhs.small_);
   num_.swap(rhs.num_);
   demon_.swap(rhs.demon_);
 }
 
 int Rational::compare(const Rational& rhs) const {
-  auto tmp_lhs{*this};
-  auto tmp_rhs{rhs};
-  tmp_lhs.num_ *= tmp_rhs.demon_;
-  tmp_rhs.num_ *= tmp_lhs.demon_;
-  if (tmp_lhs.num_ < tmp_rhs.num_)
-    return -1;
-
-  if (tmp_lhs.num_ > tmp_rhs.num_)
-    return 1;
-
-  return 0;
+  std::int64_t lhs_cross{};
+  std::int64_t rhs_cross{};
+  if (small_ && rhs.small_ &&
+      details::checkedMultiply(small_num_, rhs.small_demon_, lhs_cross) &&
+      details::checkedMultiply(rhs.small_num_, small_demon_, rhs_cross))
+    return lhs_cross < rhs_cross ? -1 : (lhs_cross > rhs_cross ? 1 : 0);
+
+  BigInteger lhs_num{};
+  BigInteger lhs_denom{};
+  BigInteger rhs_num{};
+  BigInteger rhs_denom{};
+  return details::compare(bigNumerator(lhs_num), bigDenominator(lhs_denom),
+                          rhs.bigNumerator(rhs_num),
+                          rhs.bigDenominator(rhs_denom));
 }
 
 std::istream& Rational::dump(std::istream& in) {
-  std::string num{};
-  std::getline(in, num, '/');
-  std::string denom{};
-  std::getline(in, denom);
-  num_ = num;
-  demon_ = denom;
-  if (!demon_)
-    throw std::runtime_error("the denominator is zero");
+  std::string token{};
+  if (!(in >> token))
+    return in;
+
+  auto last = token.data() + token.size();
+  auto [ptr, ec] = fromChars(token.data(), last, *this);
+  if (ec != std::errc{} || ptr != last)
+    throw std::runtime_error("malformed rational at character " +
+                             std::to_string(ptr - token.data() + 1));
 
   return in;
 }
 
+std::from_chars_result fromChars(const char* first, const char* last,
+                                 Rational& value) {
+  auto pos = first;
+  bool negative = pos != last && *pos == '-';
+  if (pos != last && (*pos == '-' || *pos == '+'))
+    ++pos;
+
+  auto integer_end = details::skipDigits(pos, last);
+  if (integer_end == pos)
+    return {pos, std::errc::invalid_argument};
+
+  std::string_view integer{pos, integer_end};
+  std::string_view fraction{};
+  std::string_view denominator{};
+  pos = integer_end;
+  if (pos != last && (*pos == '/' || *pos == '.')) {
+    auto is_fraction = *pos++ == '.';
+    auto digits_end = details::skipDigits(pos, last);
+    if (digits_end == pos)
+      return {pos, std::errc::invalid_argument};
+
+    std::string_view digits{pos, digits_end};
+    if (is_fraction) {
+      fraction = digits;
+    } else if (digits.find_first_not_of('0') == std::string_view::npos) {
+      return {pos, std::errc::invalid_argument};
+    } else {
+      denominator = digits;
+    }
+
+    pos = digits_end;
+  }
+
+  value.assign(negative, integer, fraction, denominator);
+  return {pos, std::errc{}};
+}
+
 Rational operator+(const Rational& lhs, const Rational& rhs) {
   auto tmp{lhs};
   tmp += rhs;
@@ -155,7 +804,17 @@ Rational operator/(const Rational& lhs, const Rational& rhs) {
 }
 
 bool operator==(const Rational& lhs, const Rational& rhs) {
-  return lhs.compare(rhs) == 0;
+  // both sides are kept reduced, so equal values have equal parts
+  if (lhs.small_ && rhs.small_)
+    return lhs.small_num_ == rhs.small_num_ &&
+           lhs.small_demon_ == rhs.small_demon_;
+
+  BigInteger lhs_num{};
+  BigInteger lhs_denom{};
+  BigInteger rhs_num{};
+  BigInteger rhs_denom{};
+  return lhs.bigNumerator(lhs_num) == rhs.bigNumerator(rhs_num) &&
+         lhs.bigDenominator(lhs_denom) == rhs.bigDenominator(rhs_denom);
 }
 
 bool operator!=(const Rational& lhs, const Rational& rhs) {
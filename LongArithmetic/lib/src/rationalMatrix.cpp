@@ -0,0 +1,223 @@
+#include "long_arithmetic/rationalMatrix.h"
+
+#include <exception>
+#include <utility>
+
+
+namespace details {
+
+// fraction-free elimination of a rows x cols integer matrix in place,
+// pivots are searched in the first pivot_cols columns only. Every entry
+// below the pivots is a minor of the input, so the division by the
+// previous pivot is exact. Returns the rank, sign follows the row swaps
+std::size_t bareiss(std::vector<BigInteger>& matrix, std::size_t rows,
+                    std::size_t cols, std::size_t pivot_cols, int& sign) {
+  auto at = [&matrix, cols](std::size_t row, std::size_t col) -> BigInteger& {
+    return matrix[row * cols + col];
+  };
+
+  sign = 1;
+  BigInteger prev_pivot{1};
+  std::size_t rank{0};
+  for (std::size_t col = 0; col < pivot_cols && rank < rows; ++col) {
+    auto pivot_row = rank;
+    while (pivot_row < rows && !at(pivot_row, col))
+      ++pivot_row;
+
+    if (pivot_row == rows)
+      continue;
+
+    if (pivot_row != rank) {
+      for (std::size_t j = col; j < cols; ++j)
+        at(pivot_row, j).swap(at(rank, j));
+
+      sign = -sign;
+    }
+
+    const auto& pivot = at(rank, col);
+    for (auto row = rank + 1; row < rows; ++row) {
+      for (auto j = col + 1; j < cols; ++j) {
+        auto& entry = at(row, j);
+        entry *= pivot;
+        entry -= at(row, col) * at(rank, j);
+        if (prev_pivot != 1)
+          entry /= prev_pivot;
+      }
+
+      at(row, col) = 0;
+    }
+
+    prev_pivot = pivot;
+    ++rank;
+  }
+
+  return rank;
+}
+
+} // namespace details //-----------------------------------------------//
+
+// RationalMatrix implementation //-------------------------------------//
+RationalMatrix::RationalMatrix(std::size_t rows, std::size_t cols)
+    : rows_{rows}, cols_{cols}, values_(rows * cols) {
+}
+
+RationalMatrix::RationalMatrix(
+    std::initializer_list<std::initializer_list<Rational>> rows)
+    : rows_{rows.size()}, cols_{rows.size() ? rows.begin()->size() : 0} {
+  values_.reserve(rows_ * cols_);
+  for (auto&& row : rows) {
+    if (row.size() != cols_)
+      throw std::runtime_error("matrix rows of different length");
+
+    values_.insert(values_.end(), row.begin(), row.end());
+  }
+}
+
+RationalMatrix RationalMatrix::identity(std::size_t size) {
+  RationalMatrix res{size, size};
+  for (std::size_t i = 0; i < size; ++i)
+    res(i, i) = 1;
+
+  return res;
+}
+
+std::size_t RationalMatrix::rows() const noexcept {
+  return rows_;
+}
+
+std::size_t RationalMatrix::cols() const noexcept {
+  return cols_;
+}
+
+Rational& RationalMatrix::operator()(std::size_t row, std::size_t col) {
+  return values_[row * cols_ + col];
+}
+
+const Rational& RationalMatrix::operator()(std::size_t row,
+                                           std::size_t col) const {
+  return values_[row * cols_ + col];
+}
+
+// every row times the lcm of its denominators, scale gets the product of
+// the factors when given
+std::vector<BigInteger> RationalMatrix::integerRows(BigInteger* scale) const {
+  std::vector<BigInteger> res{};
+  res.reserve(values_.size());
+  if (scale)
+    *scale = 1;
+
+  for (std::size_t row = 0; row < rows_; ++row) {
+    BigInteger factor{1};
+    for (std::size_t col = 0; col < cols_; ++col) {
+      auto denom = (*this)(row, col).denominator();
+      if (denom != 1)
+        factor = lcm(factor, denom);
+    }
+
+    for (std::size_t col = 0; col < cols_; ++col) {
+      const auto& value = (*this)(row, col);
+      auto denom = value.denominator();
+      res.push_back(denom == factor ? value.numerator()
+                                    : value.numerator() * (factor / denom));
+    }
+
+    if (scale && factor != 1)
+      *scale *= factor;
+  }
+
+  return res;
+}
+
+// the last Bareiss pivot is the determinant of the scaled rows
+Rational RationalMatrix::determinant() const {
+  if (rows_ != cols_)
+    throw std::runtime_error("determinant of a non-square matrix");
+
+  if (!rows_)
+    return 1;
+
+  BigInteger scale{};
+  auto matrix = integerRows(&scale);
+  int sign{};
+  if (details::bareiss(matrix, rows_, cols_, cols_, sign) < rows_)
+    return 0;
+
+  auto det = std::move(matrix.back());
+  if (sign < 0)
+    det = -det;
+
+  return Rational{det, scale};
+}
+
+std::size_t RationalMatrix::rank() const {
+  auto matrix = integerRows(nullptr);
+  int sign{};
+  return details::bareiss(matrix, rows_, cols_, cols_, sign);
+}
+
+// eliminates the augmented matrix [A | rhs], then back substitutes
+// t = det * x, which is integral by Cramer's rule, so its divisions are
+// exact too and only the final x = t / det are reduced
+std::vector<Rational> RationalMatrix::solve(
+    const std::vector<Rational>& rhs) const {
+  if (rows_ != cols_)
+    throw std::runtime_error("solve with a non-square matrix");
+
+  if (rhs.size() != rows_)
+    throw std::runtime_error("right-hand side of a different size");
+
+  if (!rows_)
+    return {};
+
+  RationalMatrix augmented{rows_, cols_ + 1};
+  for (std::size_t row = 0; row < rows_; ++row) {
+    for (std::size_t col = 0; col < cols_; ++col)
+      augmented(row, col) = (*this)(row, col);
+
+    augmented(row, cols_) = rhs[row];
+  }
+
+  auto size = rows_;
+  auto width = cols_ + 1;
+  auto matrix = augmented.integerRows(nullptr);
+  int sign{};
+  if (details::bareiss(matrix, size, width, size, sign) < size)
+    throw std::runtime_error("the matrix is singular");
+
+  auto at = [&matrix, width](std::size_t row,
+                             std::size_t col) -> const BigInteger& {
+    return matrix[row * width + col];
+  };
+
+  const auto det = matrix[(size - 1) * width + size - 1];
+  std::vector<BigInteger> scaled(size);
+  std::vector<Rational> res(size);
+  for (auto row = size; row-- > 0;) {
+    auto sum = det * at(row, size);
+    for (auto col = row + 1; col < size; ++col)
+      sum -= at(row, col) * scaled[col];
+
+    scaled[row] = sum / at(row, row);
+    res[row] = Rational{scaled[row], det};
+  }
+
+  return res;
+}
+
+bool operator==(const RationalMatrix& lhs, const RationalMatrix& rhs) {
+  if (lhs.rows() != rhs.rows() || lhs.cols() != rhs.cols())
+    return false;
+
+  for (std::size_t row = 0; row < lhs.rows(); ++row) {
+    for (std::size_t col = 0; col < lhs.cols(); ++col) {
+      if (lhs(row, col) != rhs(row, col))
+        return false;
+    }
+  }
+
+  return true;
+}
+
+bool operator!=(const RationalMatrix& lhs, const RationalMatrix& rhs) {
+  return !(lhs == rhs);
+}
@@ -0,0 +1,29 @@
+#include "long_arithmetic/rounding.h"
+
+
+namespace details {
+
+bool roundAway(RoundingMode mode, bool negative, bool odd,
+               int half, bool exact) {
+  if (exact)
+    return false;
+
+  switch (mode) {
+    case RoundingMode::HalfEven:
+      return half > 0 || (half == 0 && odd);
+    case RoundingMode::HalfAwayFromZero:
+      return half >= 0;
+    case RoundingMode::TowardZero:
+      return false;
+    case RoundingMode::AwayFromZero:
+      return true;
+    case RoundingMode::Floor:
+      return negative;
+    case RoundingMode::Ceiling:
+      return !negative;
+  }
+
+  return false;
+}
+
+} // namespace details //-----------------------------------------------//
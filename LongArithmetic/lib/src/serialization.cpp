@@ -0,0 +1,224 @@
+#include "long_arithmetic/serialization.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+namespace details {
+
+bool isSpace(char symbol) {
+  return symbol == ' ' || (symbol >= '\t' && symbol <= '\r');
+}
+
+} // namespace details //-----------------------------------------------//
+
+
+// BinaryWriter implementation //---------------------------------------//
+BinaryWriter::BinaryWriter(std::ostream& out, std::size_t buffer_size)
+    : out_{out} {
+  buffer_.reserve(buffer_size ? buffer_size : 1);
+}
+
+BinaryWriter::~BinaryWriter() {
+  flush();
+}
+
+void BinaryWriter::put(char byte) {
+  if (buffer_.size() == buffer_.capacity())
+    flush();
+
+  buffer_.push_back(byte);
+}
+
+void BinaryWriter::write(const BigInteger& value) {
+  put(static_cast<char>(value.sign_ < 0 ? 1 : 0));
+
+  std::uint64_t count = value.number_.size();
+  for (std::size_t i = 0; i != 8; ++i) {
+    put(static_cast<char>((count >> (8 * i)) & 0xff));
+  }
+
+  for (std::size_t i = 0; i < value.number_.size(); i += 2) {
+    auto high = i + 1 < value.number_.size() ? value.number_[i + 1] : 0;
+    put(static_cast<char>(value.number_[i] | high << 4));
+  }
+}
+
+void BinaryWriter::write(const Rational& value) {
+  BigInteger storage{};
+  write(value.bigNumerator(storage));
+  write(value.bigDenominator(storage));
+}
+
+void BinaryWriter::flush() {
+  out_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+  buffer_.clear();
+}
+
+// BinaryReader implementation //---------------------------------------//
+BinaryReader::BinaryReader(std::istream& in, std::size_t buffer_size)
+    : in_{in}, buffer_(buffer_size ? buffer_size : 1) {
+}
+
+bool BinaryReader::fill() {
+  in_.read(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+  pos_ = 0;
+  end_ = static_cast<std::size_t>(in_.gcount());
+  return end_ != 0;
+}
+
+char BinaryReader::get() {
+  if (pos_ == end_ && !fill())
+    throw std::runtime_error("truncated binary number");
+
+  return buffer_[pos_++];
+}
+
+bool BinaryReader::read(BigInteger& value) {
+  if (pos_ == end_ && !fill())
+    return false;
+
+  auto sign = get();
+  if (sign != 0 && sign != 1)
+    throw std::runtime_error("malformed binary number");
+
+  std::uint64_t count{0};
+  for (std::size_t i = 0; i != 8; ++i) {
+    count |= static_cast<std::uint64_t>(static_cast<unsigned char>(get()))
+             << (8 * i);
+  }
+
+  // the count is not trusted for the allocation size
+  BigInteger res{};
+  auto& digits = res.number_;
+  digits.reserve(std::min<std::uint64_t>(count, 2 * buffer_.size()));
+  while (digits.size() != count) {
+    if (pos_ == end_ && !fill())
+      throw std::runtime_error("truncated binary number");
+
+    auto chunk = std::min<std::uint64_t>((count - digits.size() + 1) / 2,
+                                         end_ - pos_);
+    for (auto i = pos_; i != pos_ + chunk; ++i) {
+      auto byte = static_cast<unsigned char>(buffer_[i]);
+      int low = byte & 0x0f;
+      int high = byte >> 4;
+      if (low > 9 || high > 9)
+        throw std::runtime_error("malformed binary number");
+
+      digits.push_back(low);
+      if (digits.size() != count)
+        digits.push_back(high);
+      else if (high)
+        throw std::runtime_error("malformed binary number");
+    }
+
+    pos_ += chunk;
+  }
+
+  // only the canonical form is accepted: no leading zeros and no
+  // negative zero
+  if ((count && digits.back() == 0) || (!count && sign))
+    throw std::runtime_error("malformed binary number");
+
+  res.sign_ = sign ? -1 : 1;
+  value.swap(res);
+  return true;
+}
+
+bool BinaryReader::read(Rational& value) {
+  BigInteger num{};
+  if (!read(num))
+    return false;
+
+  BigInteger denom{};
+  if (!read(denom))
+    throw std::runtime_error("truncated binary rational");
+
+  if (denom.sign() <= 0)
+    throw std::runtime_error("malformed binary rational");
+
+  Rational res{};
+  res.num_ = std::move(num);
+  res.demon_ = std::move(denom);
+  res.small_ = false;
+  res.demote();
+  value.swap(res);
+  return true;
+}
+
+// TextReader implementation //-----------------------------------------//
+TextReader::TextReader(std::istream& in, std::size_t buffer_size)
+    : in_{in}, buffer_(buffer_size ? buffer_size : 1) {
+}
+
+// keeps the unread tail, and grows the buffer when the tail fills it
+bool TextReader::fill() {
+  std::memmove(buffer_.data(), buffer_.data() + pos_, end_ - pos_);
+  offset_ += pos_;
+  end_ -= pos_;
+  pos_ = 0;
+  if (end_ == buffer_.size())
+    buffer_.resize(2 * buffer_.size());
+
+  in_.read(buffer_.data() + end_,
+           static_cast<std::streamsize>(buffer_.size() - end_));
+  auto count = static_cast<std::size_t>(in_.gcount());
+  end_ += count;
+  return count != 0;
+}
+
+bool TextReader::read(Rational& value) {
+  while (true) {
+    if (pos_ == end_ && !fill())
+      return false;
+
+    auto symbol = buffer_[pos_];
+    if (!details::isSpace(symbol))
+      break;
+
+    ++pos_;
+    if (symbol == '\n') {
+      ++line_;
+      line_start_ = offset_ + pos_;
+    }
+  }
+
+  // the token has to lie in the buffer completely
+  auto token_end = pos_;
+  while (true) {
+    while (token_end != end_ && !details::isSpace(buffer_[token_end]))
+      ++token_end;
+
+    if (token_end != end_)
+      break;
+
+    // fill moves the token to the front even when the input has ended
+    auto shift = pos_;
+    auto more = fill();
+    token_end -= shift;
+    if (!more)
+      break;
+  }
+
+  auto first = buffer_.data() + pos_;
+  auto last = buffer_.data() + token_end;
+  auto [ptr, ec] = fromChars(first, last, value);
+  if (ec != std::errc{} || ptr != last) {
+    auto column = offset_ + static_cast<std::size_t>(ptr - buffer_.data()) -
+                  line_start_ + 1;
+    throw std::runtime_error("malformed rational at line " +
+                             std::to_string(line_) + ", column " +
+                             std::to_string(column));
+  }
+
+  pos_ = token_end;
+  return true;
+}
@@ -0,0 +1,183 @@
+#include "long_arithmetic/summation.h"
+#include "long_arithmetic/bigIntegerAccumulator.h"
+
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+
+namespace details {
+
+constexpr std::size_t kChunkSize{4096};
+
+std::size_t threadCount(std::size_t threads, std::size_t tasks) {
+  if (!threads)
+    threads = std::max(std::thread::hardware_concurrency(), 1u);
+
+  return std::min(threads, tasks);
+}
+
+// chunk sums of term(0) ... term(count - 1), merged pairwise in a balanced
+// tree. The threads are started once: the first round sums the chunks, and
+// every later round adds the sum stride chunks away to each remaining one,
+// a barrier separating the rounds. The first exception is rethrown here
+template <typename Value, typename ChunkSum>
+Value treeSum(std::size_t count, std::size_t threads, ChunkSum chunk_sum) {
+  auto chunks = (count + kChunkSize - 1) / kChunkSize;
+  if (!chunks)
+    return Value{};
+
+  std::vector<Value> partial(chunks);
+  std::size_t stride{0};
+  std::atomic<std::size_t> next{0};
+  std::exception_ptr error{};
+  std::mutex error_mutex{};
+  auto workers = threadCount(threads, chunks);
+  std::barrier sync{static_cast<std::ptrdiff_t>(workers), [&]() noexcept {
+                      stride = stride ? 2 * stride : 1;
+                      next = 0;
+                    }};
+
+  auto task = [&](std::size_t index) {
+    if (!stride) {
+      auto first = index * kChunkSize;
+      partial[index] = chunk_sum(first, std::min(first + kChunkSize, count));
+    } else {
+      partial[2 * stride * index] += partial[2 * stride * index + stride];
+    }
+  };
+
+  auto worker = [&]() {
+    while (stride < chunks) {
+      auto tasks = stride ? (chunks + stride - 1) / (2 * stride) : chunks;
+      for (auto index = next++; index < tasks; index = next++) {
+        try {
+          task(index);
+        } catch (...) {
+          std::lock_guard lock{error_mutex};
+          if (!error)
+            error = std::current_exception();
+        }
+      }
+
+      sync.arrive_and_wait();
+    }
+  };
+
+  std::vector<std::jthread> pool{};
+  try {
+    for (std::size_t i = 1; i < workers; ++i)
+      pool.emplace_back(worker);
+  } catch (...) {
+    // the threads that did not start leave the barrier to the others
+    for (auto i = pool.size() + 1; i < workers; ++i)
+      sync.arrive_and_drop();
+  }
+
+  worker();
+  pool.clear();
+  if (error)
+    std::rethrow_exception(error);
+
+  return std::move(partial.front());
+}
+
+// carries are propagated once per chunk
+template <typename Term>
+BigInteger accumulate(std::size_t first, std::size_t last, Term term) {
+  BigIntegerAccumulator acc{};
+  for (auto i = first; i < last; ++i) {
+    acc += term(i);
+  }
+
+  return acc.value();
+}
+
+// pairwise summation: levels[i] holds the sum of a block of 2^i terms, and
+// equal blocks are merged like the carries of a binary counter. The
+// denominators grow with the block instead of with the whole chunk, and
+// word-sized sums stay on the inline path of Rational
+template <typename Term>
+Rational pairwiseSum(std::size_t first, std::size_t last, Term term) {
+  std::vector<Rational> levels(1);
+  for (auto i = first; i < last; ++i) {
+    auto done = i - first;
+    if (done % 2 == 0) {
+      levels.front() = term(i);
+      continue;
+    }
+
+    // the term is added to its neighbour without a copy of its own
+    auto carry = std::move(levels.front());
+    carry += term(i);
+    std::size_t level{1};
+    for (done /= 2; done % 2; done /= 2, ++level) {
+      carry += levels[level];
+    }
+
+    if (level == levels.size()) {
+      levels.push_back(std::move(carry));
+    } else {
+      levels[level] = std::move(carry);
+    }
+  }
+
+  Rational res{};
+  for (std::size_t level = 0, done = last - first; done; done /= 2, ++level) {
+    if (done % 2)
+      res += levels[level];
+  }
+
+  return res;
+}
+
+void checkSizes(std::size_t lhs, std::size_t rhs) {
+  if (lhs != rhs)
+    throw std::runtime_error("dot product of different sizes");
+}
+
+} // namespace details //-----------------------------------------------//
+
+// Summation implementation //------------------------------------------//
+BigInteger sum(std::span<const BigInteger> terms, std::size_t threads) {
+  return details::treeSum<BigInteger>(
+      terms.size(), threads, [terms](std::size_t first, std::size_t last) {
+        return details::accumulate(
+            first, last,
+            [terms](std::size_t i) -> const BigInteger& { return terms[i]; });
+      });
+}
+
+Rational sum(std::span<const Rational> terms, std::size_t threads) {
+  return details::treeSum<Rational>(
+      terms.size(), threads, [terms](std::size_t first, std::size_t last) {
+        return details::pairwiseSum(
+            first, last,
+            [terms](std::size_t i) -> const Rational& { return terms[i]; });
+      });
+}
+
+BigInteger dot(std::span<const BigInteger> lhs,
+               std::span<const BigInteger> rhs, std::size_t threads) {
+  details::checkSizes(lhs.size(), rhs.size());
+  return details::treeSum<BigInteger>(
+      lhs.size(), threads, [lhs, rhs](std::size_t first, std::size_t last) {
+        return details::accumulate(
+            first, last, [lhs, rhs](std::size_t i) { return lhs[i] * rhs[i]; });
+      });
+}
+
+Rational dot(std::span<const Rational> lhs, std::span<const Rational> rhs,
+             std::size_t threads) {
+  details::checkSizes(lhs.size(), rhs.size());
+  return details::treeSum<Rational>(
+      lhs.size(), threads, [lhs, rhs](std::size_t first, std::size_t last) {
+        return details::pairwiseSum(
+            first, last, [lhs, rhs](std::size_t i) { return lhs[i] * rhs[i]; });
+      });
+}
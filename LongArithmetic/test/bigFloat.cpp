@@ -0,0 +1,105 @@
+#include "check.h"
+
+#include "long_arithmetic/bigFloat.h"
+
+#include <array>
+#include <cstddef>
+#include <string>
+
+
+namespace {
+
+constexpr std::array<RoundingMode, 6> kModes{
+    RoundingMode::HalfEven,     RoundingMode::HalfAwayFromZero,
+    RoundingMode::TowardZero,   RoundingMode::AwayFromZero,
+    RoundingMode::Floor,        RoundingMode::Ceiling};
+
+// every input rounded to one digit in the order of kModes
+struct RoundingCase {
+  const char* input;
+  std::array<int, 6> expected;
+};
+
+constexpr std::array<RoundingCase, 8> kCases{{
+    {"2.5", {2, 3, 2, 3, 2, 3}},
+    {"3.5", {4, 4, 3, 4, 3, 4}},
+    {"2.4", {2, 2, 2, 3, 2, 3}},
+    {"2.6", {3, 3, 2, 3, 2, 3}},
+    {"2.5000000000001", {3, 3, 2, 3, 2, 3}},
+    {"-2.5", {-2, -3, -2, -3, -3, -2}},
+    {"-2.6", {-3, -3, -2, -3, -3, -2}},
+    {"-3.5", {-4, -4, -3, -4, -4, -3}},
+}};
+
+void testRounding() {
+  for (auto&& item : kCases) {
+    for (std::size_t i = 0; i != kModes.size(); ++i) {
+      BigFloat value{item.input, 1, kModes[i]};
+      CHECK(value == BigFloat{BigInteger{item.expected[i]}});
+    }
+  }
+
+  // the carry of a rounding step can add a digit
+  CHECK(BigFloat("9.99", 2, RoundingMode::HalfEven) == BigFloat{"10"});
+  CHECK(BigFloat("-9.99", 2, RoundingMode::Floor) == BigFloat{"-10"});
+
+  // lowering the precision rounds again
+  BigFloat value{"123456", 10};
+  value.setPrecision(3);
+  CHECK(value.toString() == "123000");
+  value.setRounding(RoundingMode::Ceiling);
+  value += BigFloat{"1"};
+  CHECK(value.toString() == "124000");
+}
+
+void testConstruction() {
+  BigFloat value{BigInteger{5}, 30};
+  CHECK(value.precision() == 30 && value.toString() == "5");
+
+  auto parts = BigFloat::fromParts(BigInteger{12500}, -3, 2);
+  CHECK(parts.mantissa() == 12 && parts.exponent() == 0);
+  CHECK(parts.toString() == "12");
+  CHECK(BigFloat::fromParts(BigInteger{135}, -2, 2).toString() == "1.4");
+
+  auto zero = BigFloat::fromParts(BigInteger{0}, 42);
+  CHECK(zero.exponent() == 0 && zero.toString() == "0");
+
+  CHECK(BigFloat{"1.5e3"} == BigFloat{BigInteger{1500}});
+  CHECK(BigFloat{"-0.00025"}.toString() == "-0.00025");
+  CHECK(BigFloat{"1e40"}.toString() == "1e40");
+  CHECK_THROWS(BigFloat{"1.2.3"});
+  CHECK_THROWS(BigFloat{"e5"});
+  CHECK_THROWS(BigFloat{"1e"});
+}
+
+void testArithmetic() {
+  BigFloat third = BigFloat{"1", 20} / BigFloat{"3"};
+  CHECK(third.toString() == "0.33333333333333333333");
+
+  BigFloat two_thirds = BigFloat{"2", 20} / BigFloat{"3"};
+  CHECK(two_thirds.toString() == "0.66666666666666666667");
+
+  // a tiny addend only decides the rounding
+  BigFloat one{"1", 5, RoundingMode::Ceiling};
+  CHECK((one + BigFloat{"1e-100"}).toString() == "1.0001");
+  CHECK((BigFloat{"1", 5} + BigFloat{"1e-100"}).toString() == "1");
+
+  CHECK(sqrt(BigFloat{"2", 30}).toString() ==
+        "1.41421356237309504880168872421");
+  CHECK(sqrt(BigFloat{"1.44"}) == BigFloat{"1.2"});
+  CHECK_THROWS(sqrt(BigFloat{"-1"}));
+  CHECK_THROWS(BigFloat{"1"} / BigFloat{"0"});
+
+  CHECK(BigFloat{"1.5"} < BigFloat{"2"});
+  CHECK(BigFloat{"-1e10"} < BigFloat{"-1e9"});
+  CHECK(BigFloat{"0.001"} > BigFloat{"0"});
+}
+
+} // namespace
+
+int main() {
+  testRounding();
+  testConstruction();
+  testArithmetic();
+  return test::result();
+}
@@ -0,0 +1,101 @@
+#include "check.h"
+#include "random.h"
+
+#include "long_arithmetic/bigInteger.h"
+
+#include <climits>
+#include <random>
+#include <string>
+
+
+namespace {
+
+void testPredicates() {
+  BigInteger zero{};
+  CHECK(zero.sign() == 0 && zero.isZero() && !zero.isOdd() && !zero.isOne());
+  CHECK(BigInteger{"-0"}.sign() == 0 && BigInteger{-5 + 5}.isZero());
+  CHECK(BigInteger{1}.isOne() && !BigInteger{-1}.isOne());
+  CHECK(!BigInteger{11}.isOne() && !BigInteger{10}.isOne());
+  CHECK(BigInteger{-3}.sign() == -1 && BigInteger{-3}.isOdd());
+  CHECK(BigInteger{LLONG_MIN}.sign() == -1 && !BigInteger{LLONG_MIN}.isOdd());
+  CHECK(BigInteger{LLONG_MAX}.sign() == 1 && BigInteger{LLONG_MAX}.isOdd());
+}
+
+// one past each limit fails, the limits themselves convert exactly
+void testBoundaries() {
+  BigInteger min{LLONG_MIN};
+  BigInteger max{LLONG_MAX};
+  BigInteger umax{"18446744073709551615"};
+  CHECK(min.toString() == "-9223372036854775808");
+  CHECK(min.fits<long long>() && min.to<long long>() == LLONG_MIN);
+  CHECK(!(min - 1).fits<long long>() && !min.fits<unsigned long long>());
+  CHECK(max.fits<long long>() && max.to<long long>() == LLONG_MAX);
+  CHECK(!(max + 1).fits<long long>() && (max + 1).fits<unsigned long long>());
+  CHECK(umax.fits<unsigned long long>());
+  CHECK(umax.to<unsigned long long>() == ULLONG_MAX);
+  CHECK(!(umax + 1).fits<unsigned long long>() && !umax.fits<long long>());
+  CHECK(-min == max + 1 && abs(min) == max + 1);
+  CHECK(BigInteger{INT_MIN}.to<int>() == INT_MIN);
+  CHECK(!BigInteger{static_cast<long long>(INT_MAX) + 1}.fits<int>());
+  CHECK(BigInteger{-1}.fits<int>() && !BigInteger{-1}.fits<unsigned>());
+  CHECK_THROWS((umax + 1).to<unsigned long long>());
+  CHECK_THROWS(BigInteger{-1}.to<unsigned long>());
+}
+
+// Euclid with full divisions as the reference
+BigInteger euclid(BigInteger lhs, BigInteger rhs) {
+  lhs = abs(lhs);
+  rhs = abs(rhs);
+  while (rhs) {
+    lhs %= rhs;
+    swap(lhs, rhs);
+  }
+
+  return lhs;
+}
+
+void testGcd() {
+  CHECK(gcd(0, 0) == 0);
+  CHECK(gcd(0, -7) == 7);
+  CHECK(gcd(-12, 18) == 6);
+  CHECK(gcd(BigInteger{"1000000000000000000"}, 64) == 64);
+
+  // both operands on the word path, at its 18 digit edge and past it
+  BigInteger word{"999999999999999999"};
+  BigInteger third{"333333333333333333"};
+  CHECK(gcd(word, third) == third && gcd(-third, word) == third);
+  CHECK(gcd(word * 10, word * 4) == word * 2);
+  CHECK(gcd(LLONG_MIN, LLONG_MIN) == -BigInteger{LLONG_MIN});
+  CHECK(gcd(LLONG_MAX, LLONG_MAX - 1) == 1 && gcd(LLONG_MIN, 6) == 2);
+
+  // a common factor makes the Lehmer steps end in a large gcd
+  std::mt19937 gen{50};
+  for (int i = 0; i != 200; ++i) {
+    auto factor = test::randomNumber(gen, 1 + i % 40);
+    auto lhs = test::randomNumber(gen, 1 + i % 120) * factor;
+    auto rhs = test::randomNumber(gen, 1 + (i * 7) % 120) * factor;
+    auto res = gcd(lhs, rhs);
+    CHECK(res == euclid(lhs, rhs));
+    CHECK(res == gcd(rhs, lhs));
+  }
+
+  // consecutive Fibonacci numbers have every quotient equal to one
+  BigInteger prev{1};
+  BigInteger last{1};
+  for (int i = 0; i != 300; ++i) {
+    prev += last;
+    swap(prev, last);
+  }
+
+  CHECK(gcd(last, prev) == 1);
+  CHECK(gcd(last * 91, prev * 91) == 91);
+}
+
+} // namespace
+
+int main() {
+  testPredicates();
+  testBoundaries();
+  testGcd();
+  return test::result();
+}
@@ -0,0 +1,91 @@
+#include "check.h"
+#include "random.h"
+
+#include "long_arithmetic/bigIntegerAccumulator.h"
+#include "long_arithmetic/bigIntegerView.h"
+#include "long_arithmetic/serialization.h"
+
+#include <random>
+#include <sstream>
+#include <string>
+
+
+namespace {
+
+// compares the accumulator with a running sum after every few terms,
+// reading the value in between must not disturb the following terms
+void testRandomSums() {
+  std::mt19937 gen{33};
+  BigIntegerAccumulator acc{};
+  BigInteger expected{};
+  for (int i = 0; i != 2000; ++i) {
+    auto term = test::randomNumber(gen, i % 7 == 0 ? 120 : 25);
+    if (i % 3 == 0) {
+      acc -= term;
+      expected -= term;
+    } else {
+      acc += term;
+      expected += term;
+    }
+
+    if (i % 97 == 0)
+      CHECK(acc.value() == expected);
+  }
+
+  CHECK(acc.value() == expected);
+
+  acc.clear();
+  CHECK(acc.value() == 0);
+}
+
+void testCancellation() {
+  BigInteger big{"1" + std::string(200, '0')};
+  BigIntegerAccumulator acc{big};
+  acc -= big;
+  acc += BigInteger{-1};
+  CHECK(acc.value() == -1);
+
+  acc -= BigInteger{-1};
+  acc.normalize();
+  CHECK(acc.value() == 0);
+  CHECK(acc.value().sign() == 0);
+
+  // borrows through a long run of zeros
+  BigIntegerAccumulator borrow{big};
+  borrow -= BigInteger{1};
+  CHECK(borrow.value() == BigInteger{std::string(200, '9')});
+}
+
+void testViews() {
+  std::mt19937 gen{34};
+  BigIntegerAccumulator acc{};
+  BigInteger expected{};
+  for (int i = 0; i != 300; ++i) {
+    auto term = test::randomNumber(gen, 60);
+    std::ostringstream out{};
+    BinaryWriter{out}.write(term);
+    auto digits = out.str().substr(9);
+    BigIntegerView view{
+        term.sign(),
+        PackedDigits{reinterpret_cast<const unsigned char*>(digits.data()),
+                     term.limbCount()}};
+    if (i % 2 == 0) {
+      acc += view;
+      expected += term;
+    } else {
+      acc -= view;
+      expected -= term;
+    }
+  }
+
+  CHECK(acc.value() == expected);
+}
+
+} // namespace
+
+int main() {
+  testRandomSums();
+  testCancellation();
+  testViews();
+  return test::result();
+}
@@ -0,0 +1,97 @@
+#include "check.h"
+#include "random.h"
+
+#include "long_arithmetic/bigIntegerArray.h"
+
+#include <cstddef>
+#include <random>
+#include <vector>
+
+
+namespace {
+
+// the array is compared with a plain vector of the same numbers
+bool matches(const BigIntegerArray& array,
+             const std::vector<BigInteger>& values) {
+  if (array.size() != values.size())
+    return false;
+
+  for (std::size_t i = 0; i != values.size(); ++i) {
+    if (array[i] != values[i])
+      return false;
+  }
+
+  return true;
+}
+
+std::vector<BigInteger> randomValues(std::mt19937& gen, std::size_t count,
+                                     std::size_t max_digits) {
+  std::vector<BigInteger> res{};
+  for (std::size_t i = 0; i != count; ++i) {
+    res.push_back(test::randomNumber(gen, max_digits));
+  }
+
+  return res;
+}
+
+void testStorage() {
+  BigIntegerArray array{};
+  CHECK(array.empty() && array.size() == 0);
+
+  std::vector<BigInteger> values{0, -1, 9, -10, 99999, BigInteger{"-123"}};
+  for (auto&& value : values) {
+    array.push_back(value);
+  }
+
+  CHECK(matches(array, values));
+  // a wider value widens the whole array
+  values[2] = BigInteger{"-98765432109876543210"};
+  array.set(2, values[2]);
+  CHECK(matches(array, values));
+  CHECK(array.width() > 20);
+  CHECK(matches(BigIntegerArray{values}, values));
+}
+
+void testArithmetic() {
+  std::mt19937 gen{27};
+  for (int round = 0; round != 50; ++round) {
+    auto lhs = randomValues(gen, 40, 30);
+    auto rhs = randomValues(gen, 40, 30);
+    BigIntegerArray array{lhs};
+    array += BigIntegerArray{rhs};
+    for (std::size_t i = 0; i != lhs.size(); ++i) {
+      lhs[i] += rhs[i];
+    }
+
+    CHECK(matches(array, lhs));
+
+    auto scalar = static_cast<int>(gen() % 2001) - 1000;
+    array *= scalar;
+    BigInteger total{};
+    for (auto&& item : lhs) {
+      item *= scalar;
+      total += item;
+    }
+
+    CHECK(matches(array, lhs));
+    CHECK(array.sum() == total);
+
+    auto order = BigIntegerArray{lhs}.compare(BigIntegerArray{rhs});
+    for (std::size_t i = 0; i != lhs.size(); ++i) {
+      auto expected = lhs[i] < rhs[i] ? -1 : lhs[i] == rhs[i] ? 0 : 1;
+      CHECK(order[i] == expected);
+    }
+  }
+
+  BigIntegerArray shorter{std::vector<BigInteger>{1, 2}};
+  CHECK_THROWS(shorter += BigIntegerArray{std::vector<BigInteger>{1}});
+  CHECK_THROWS(shorter.compare(BigIntegerArray{}));
+}
+
+} // namespace
+
+int main() {
+  testStorage();
+  testArithmetic();
+  return test::result();
+}
@@ -0,0 +1,49 @@
+#pragma once
+#ifndef CHECK_H_
+#define CHECK_H_
+
+#include <exception>
+#include <iostream>
+
+
+// minimal assertions for the test executables: a failed check is
+// reported with its location and the run goes on, main returns result()
+
+namespace test {
+
+inline int failures{0};
+
+inline void check(bool condition, const char* expression, const char* file,
+                  int line) {
+  if (condition)
+    return;
+
+  ++failures;
+  std::cerr << file << ":" << line << ": check failed: " << expression
+            << "\n";
+}
+
+inline int result() {
+  if (failures)
+    std::cerr << failures << " checks failed\n";
+
+  return failures ? 1 : 0;
+}
+
+} // namespace test
+
+#define CHECK(condition) \
+  test::check(static_cast<bool>(condition), #condition, __FILE__, __LINE__)
+
+#define CHECK_THROWS(expression)                                   \
+  do {                                                             \
+    bool thrown{false};                                            \
+    try {                                                          \
+      static_cast<void>(expression);                               \
+    } catch (const std::exception&) {                              \
+      thrown = true;                                               \
+    }                                                              \
+    test::check(thrown, "throws " #expression, __FILE__, __LINE__); \
+  } while (false)
+
+#endif // CHECK_H_ //--------------------------------------------------//
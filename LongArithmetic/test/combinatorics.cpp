@@ -0,0 +1,69 @@
+#include "check.h"
+
+#include "long_arithmetic/combinatorics.h"
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+
+namespace {
+
+void testProduct() {
+  CHECK(product(std::vector<BigInteger>{}) == 1);
+  CHECK(product(std::vector<BigInteger>{7}) == 7);
+  CHECK(product(std::vector<int>{2, 3, 5, 7, 11}) == 2310);
+  CHECK(product(std::vector<int>{-2, 3, -5}) == 30);
+  CHECK(product(std::vector<int>{4, 0, 9}) == 0);
+}
+
+void testFactorial() {
+  BigInteger expected{1};
+  for (std::uint64_t n = 0; n <= 300; ++n) {
+    if (n)
+      expected *= static_cast<long long>(n);
+
+    CHECK(factorial(n) == expected);
+  }
+
+  CHECK(factorial(25) == BigInteger{"15511210043330985984000000"});
+}
+
+void testBinomial() {
+  // the Pascal triangle covers both the falling product and the sieve
+  std::vector<BigInteger> row{1};
+  for (std::uint64_t n = 0; n <= 80; ++n) {
+    for (std::uint64_t k = 0; k <= n; ++k) {
+      CHECK(binomial(n, k) == row[k]);
+    }
+
+    CHECK(binomial(n, n + 1) == 0);
+    std::vector<BigInteger> next(row.size() + 1, 0);
+    for (std::size_t k = 0; k != row.size(); ++k) {
+      next[k] += row[k];
+      next[k + 1] += row[k];
+    }
+
+    row = std::move(next);
+  }
+
+  CHECK(binomial(100, 50) ==
+        BigInteger{"100891344545564193334812497256"});
+  CHECK(binomial(1'000'000'000, 2) == BigInteger{"499999999500000000"});
+  CHECK(binomial(1'000'000'000, 999'999'997) ==
+        BigInteger{"166666666166666667000000000"});
+
+  auto max = std::numeric_limits<std::uint64_t>::max();
+  CHECK(binomial(max, 1) == BigInteger{"18446744073709551615"});
+  CHECK(binomial(max, 2) ==
+        BigInteger{"170141183460469231704017187605319778305"});
+}
+
+} // namespace
+
+int main() {
+  testProduct();
+  testFactorial();
+  testBinomial();
+  return test::result();
+}
@@ -0,0 +1,88 @@
+#include "check.h"
+#include "random.h"
+
+#include "long_arithmetic/bigIntegerView.h"
+#include "long_arithmetic/internTable.h"
+#include "long_arithmetic/serialization.h"
+
+#include <cstddef>
+#include <functional>
+#include <random>
+#include <sstream>
+#include <string>
+#include <unordered_set>
+
+
+namespace {
+
+// the packed digits of value in the binary layout, they follow the sign
+// byte and the 8 byte count
+std::string packedDigits(const BigInteger& value) {
+  std::ostringstream out{};
+  BinaryWriter{out}.write(value);
+  return out.str().substr(9);
+}
+
+BigIntegerView viewOf(const BigInteger& value, const std::string& digits) {
+  return BigIntegerView{
+      value.sign(),
+      PackedDigits{reinterpret_cast<const unsigned char*>(digits.data()),
+                   value.limbCount()}};
+}
+
+void testHash() {
+  std::hash<BigInteger> hash{};
+  CHECK(hash(BigInteger{"000123"}) == hash(BigInteger{123}));
+  CHECK(hash(BigInteger{"-0"}) == hash(BigInteger{0}));
+  CHECK(hash(BigInteger{100} - BigInteger{1}) == hash(BigInteger{99}));
+  CHECK(hash(BigInteger{5}) != hash(BigInteger{-5}));
+
+  // consecutive numbers of every length should hardly collide
+  std::unordered_set<std::size_t> hashes{};
+  BigInteger value{"123456789012345678901234567890"};
+  for (int i = 0; i != 10000; ++i) {
+    hashes.insert(hash(value + i));
+    hashes.insert(hash(BigInteger{i}));
+  }
+
+  CHECK(hashes.size() >= 19990);
+
+  std::mt19937 gen{31};
+  for (int i = 0; i != 200; ++i) {
+    auto number = test::randomNumber(gen, 80);
+    auto digits = packedDigits(number);
+    CHECK(viewOf(number, digits).hash() == number.hash());
+  }
+}
+
+void testIntern() {
+  InternTable table{};
+  const auto& first = table.intern(BigInteger{"98765432109876543210"});
+  const auto& second = table.intern(BigInteger{"098765432109876543210"});
+  CHECK(&first == &second && table.size() == 1);
+
+  BigInteger moved{-42};
+  const auto& third = table.intern(std::move(moved));
+  CHECK(third == -42 && table.size() == 2);
+
+  BigInteger number{-42};
+  auto digits = packedDigits(number);
+  CHECK(&table.intern(viewOf(number, digits)) == &third);
+  CHECK(table.size() == 2);
+
+  BigInteger fresh{"31415926535"};
+  auto fresh_digits = packedDigits(fresh);
+  CHECK(table.intern(viewOf(fresh, fresh_digits)) == fresh);
+  CHECK(table.size() == 3);
+
+  table.clear();
+  CHECK(table.size() == 0);
+}
+
+} // namespace
+
+int main() {
+  testHash();
+  testIntern();
+  return test::result();
+}
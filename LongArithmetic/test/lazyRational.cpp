@@ -0,0 +1,114 @@
+#include "check.h"
+#include "random.h"
+
+#include "long_arithmetic/lazyRational.h"
+
+#include <cstddef>
+#include <random>
+
+
+namespace {
+
+Rational randomRational(std::mt19937& gen, std::size_t max_digits) {
+  auto denom = test::randomNumber(gen, max_digits);
+  return Rational{test::randomNumber(gen, max_digits), denom ? denom : 1};
+}
+
+// the same random operations on Rational and LazyRational, with
+// thresholds that reduce after almost every operation, now and then, and
+// only when the value is read
+void testAgainstRational(std::size_t threshold) {
+  std::mt19937 gen{36};
+  Rational expected{1};
+  LazyRational value{Rational{1}, threshold};
+  for (int i = 0; i != 160; ++i) {
+    auto operand = randomRational(gen, 4);
+    LazyRational lazy_operand{operand};
+    switch (i % 4) {
+    case 0:
+      expected += operand;
+      value += lazy_operand;
+      break;
+    case 1:
+      expected -= operand;
+      value -= lazy_operand;
+      break;
+    case 2:
+      expected *= operand;
+      value *= lazy_operand;
+      break;
+    default:
+      if (operand == 0)
+        break;
+
+      expected /= operand;
+      value /= lazy_operand;
+      break;
+    }
+
+    CHECK((value <=> LazyRational{expected}) == 0);
+    if (i % 20 == 0)
+      CHECK(value.value() == expected);
+  }
+
+  CHECK(value.value() == expected);
+  CHECK(value.toString() == expected.toString());
+}
+
+// unreduced fractions with a shared denominator
+void testCommonDenominator() {
+  LazyRational sum{};
+  Rational expected{};
+  for (int i = 1; i != 200; ++i) {
+    Rational term{BigInteger{i}, BigInteger{600}};
+    sum += LazyRational{term};
+    expected += term;
+  }
+
+  CHECK(sum.value() == expected);
+  CHECK(sum.value() == Rational(BigInteger{199}, BigInteger{6}));
+}
+
+// cross-multiplied sums, reduced only by the doubling trigger
+void testDistinctDenominators() {
+  for (std::size_t threshold : {8, 1024}) {
+    LazyRational sum{Rational{}, threshold};
+    Rational expected{};
+    for (long long k = 1; k != 120; ++k) {
+      Rational term{BigInteger{1}, BigInteger{7919 * k + 13}};
+      k % 3 ? sum += LazyRational{term} : sum -= LazyRational{term};
+      k % 3 ? expected += term : expected -= term;
+    }
+
+    CHECK(sum.value() == expected);
+  }
+}
+
+void testOrdering() {
+  LazyRational third{Rational{BigInteger{1}, BigInteger{3}}};
+  LazyRational half{Rational{BigInteger{1}, BigInteger{2}}};
+  CHECK(third < half && half > third);
+
+  // 2/6 unreduced against 1/3
+  auto unreduced = third * LazyRational{Rational{2}} /
+                   LazyRational{Rational{2}};
+  CHECK(unreduced == third);
+  CHECK(LazyRational{} - half < third - half);
+  CHECK_THROWS(half / LazyRational{});
+
+  LazyRational large{Rational{BigInteger{1}, BigInteger{3}}, 4};
+  large.setThreshold(1);
+  CHECK(large.threshold() == 1 && large == third);
+}
+
+} // namespace
+
+int main() {
+  testAgainstRational(1);
+  testAgainstRational(64);
+  testAgainstRational(100000);
+  testCommonDenominator();
+  testDistinctDenominators();
+  testOrdering();
+  return test::result();
+}
@@ -0,0 +1,31 @@
+#pragma once
+#ifndef RANDOM_H_
+#define RANDOM_H_
+
+#include "long_arithmetic/bigInteger.h"
+
+#include <cstddef>
+#include <random>
+#include <string>
+
+
+namespace test {
+
+// up to max_digits random digits with a random sign, zero included
+inline BigInteger randomNumber(std::mt19937& gen, std::size_t max_digits) {
+  std::uniform_int_distribution<std::size_t> length{1, max_digits};
+  std::uniform_int_distribution<int> digit{0, 9};
+  std::string digits(length(gen), '0');
+  for (auto&& item : digits) {
+    item = static_cast<char>('0' + digit(gen));
+  }
+
+  if (digit(gen) % 2)
+    digits.insert(digits.begin(), '-');
+
+  return BigInteger{digits};
+}
+
+} // namespace test
+
+#endif // RANDOM_H_ //-------------------------------------------------//
@@ -0,0 +1,455 @@
+#include "check.h"
+#include "random.h"
+
+#include "long_arithmetic/rational.h"
+#include "long_arithmetic/rounding.h"
+
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <vector>
+
+
+namespace {
+
+Rational randomRational(std::mt19937& gen, std::size_t max_digits) {
+  auto denom = test::randomNumber(gen, max_digits);
+  return Rational{test::randomNumber(gen, max_digits), denom ? denom : 1};
+}
+
+Rational fromTerms(const std::vector<BigInteger>& terms) {
+  Rational res{terms.back()};
+  for (auto it = terms.rbegin() + 1; it != terms.rend(); ++it) {
+    res = Rational{*it} + Rational{1} / res;
+  }
+
+  return res;
+}
+
+Rational distance(const Rational& lhs, const Rational& rhs) {
+  auto res = lhs - rhs;
+  return res < 0 ? -res : res;
+}
+
+void testContinuedFraction() {
+  Rational value{BigInteger{415}, BigInteger{93}};
+  CHECK(value.continuedFraction() ==
+        (std::vector<BigInteger>{4, 2, 6, 7}));
+  // the first term is the floor, the others are positive
+  CHECK((-value).continuedFraction() ==
+        (std::vector<BigInteger>{-5, 1, 1, 6, 7}));
+  CHECK(Rational{5}.continuedFraction() == std::vector<BigInteger>{5});
+  CHECK(Rational{}.continuedFraction() == std::vector<BigInteger>{0});
+
+  std::mt19937 gen{40};
+  for (int i = 0; i != 200; ++i) {
+    auto number = randomRational(gen, 30);
+    auto terms = number.continuedFraction();
+    CHECK(fromTerms(terms) == number);
+    for (std::size_t j = 1; j < terms.size(); ++j) {
+      CHECK(terms[j] > 0);
+    }
+  }
+}
+
+void testLimitDenominator() {
+  Rational pi{BigInteger{3141592653589793}, BigInteger{1000000000000000}};
+  CHECK(pi.limitDenominator(10) == Rational(BigInteger{22}, BigInteger{7}));
+  CHECK(pi.limitDenominator(100) == Rational(BigInteger{311}, BigInteger{99}));
+  CHECK(pi.limitDenominator(1000) ==
+        Rational(BigInteger{355}, BigInteger{113}));
+  CHECK((-pi).limitDenominator(10) ==
+        Rational(BigInteger{-22}, BigInteger{7}));
+  CHECK(pi.limitDenominator(1) == 3);
+  CHECK(pi.limitDenominator(BigInteger{"10000000000000000"}) == pi);
+  CHECK_THROWS(pi.limitDenominator(0));
+
+  // against every denominator up to the bound, ties may go either way
+  std::mt19937 gen{41};
+  for (int i = 0; i != 100; ++i) {
+    auto number = randomRational(gen, 6);
+    int bound = 1 + i % 40;
+    auto best = number.limitDenominator(bound);
+    CHECK(best.denominator() <= bound);
+
+    auto error = distance(best, number);
+    for (int denom = 1; denom <= bound; ++denom) {
+      auto scaled = number * Rational{denom};
+      auto floor = scaled.numerator() / scaled.denominator();
+      for (auto num : {floor - 1, floor, floor + 1}) {
+        CHECK(error <= distance(Rational{num, denom}, number));
+      }
+    }
+  }
+}
+
+// d is the double nearest to value, on a tie the one with an even mantissa
+void checkNearest(const Rational& value, double d) {
+  auto error = distance(Rational::fromDouble(d), value);
+  for (auto next :
+       {std::nextafter(d, -HUGE_VAL), std::nextafter(d, HUGE_VAL)}) {
+    if (!std::isfinite(next))
+      continue;
+
+    auto other = distance(Rational::fromDouble(next), value);
+    CHECK(error <= other);
+    if (error == other)
+      CHECK(std::bit_cast<std::uint64_t>(d) % 2 == 0);
+  }
+}
+
+void testToDouble() {
+  CHECK(Rational(BigInteger{1}, BigInteger{3}).toDouble() == 1.0 / 3);
+  CHECK(Rational(BigInteger{1}, BigInteger{10}).toDouble() == 0.1);
+  CHECK(Rational(BigInteger{-7}, BigInteger{2}).toDouble() == -3.5);
+  CHECK(Rational{}.toDouble() == 0);
+
+  // 2^53 + 1 is halfway and goes to the even neighbour
+  BigInteger two53{9007199254740992};
+  CHECK(Rational{two53 + 1}.toDouble() == 9007199254740992.0);
+  CHECK(Rational{two53 + 3}.toDouble() == 9007199254740996.0);
+  CHECK((two53 + 1).toDouble() == 9007199254740992.0);
+
+  BigInteger huge{"1" + std::string(400, '0')};
+  CHECK(Rational{huge}.toDouble() == HUGE_VAL);
+  CHECK(Rational{-huge}.toDouble() == -HUGE_VAL);
+  CHECK(Rational(BigInteger{1}, huge).toDouble() == 0);
+  CHECK(Rational(BigInteger{1}, BigInteger{"1" + std::string(310, '0')})
+            .toDouble() == 1e-310);
+
+  std::mt19937 gen{42};
+  for (int i = 0; i != 300; ++i) {
+    auto value = randomRational(gen, i % 2 ? 40 : 15);
+    auto d = value.toDouble();
+    checkNearest(value, d);
+    // the long double is at least as close, so within half an ulp of d
+    CHECK(std::fabs(value.toLongDouble() - d) <=
+          std::fabs(d) * std::numeric_limits<double>::epsilon());
+  }
+}
+
+void testFromDouble() {
+  CHECK(Rational::fromDouble(0.1) ==
+        Rational(BigInteger{3602879701896397},
+                 BigInteger{36028797018963968}));
+  CHECK(Rational::fromDouble(-2.5) ==
+        Rational(BigInteger{-5}, BigInteger{2}));
+  CHECK(Rational::fromDouble(-0.0) == 0);
+  CHECK(Rational::fromDouble(1e300).toDouble() == 1e300);
+  CHECK_THROWS(Rational::fromDouble(HUGE_VAL));
+  CHECK_THROWS(Rational::fromDouble(std::numeric_limits<double>::quiet_NaN()));
+
+  auto tiny = std::numeric_limits<double>::denorm_min();
+  CHECK(Rational::fromDouble(tiny).toDouble() == tiny);
+  CHECK(Rational::fromLongDouble(0.75L) ==
+        Rational(BigInteger{3}, BigInteger{4}));
+
+  // random bit patterns cover the subnormals and every exponent
+  std::mt19937_64 gen{43};
+  for (int i = 0; i != 200; ++i) {
+    auto d = std::bit_cast<double>(gen());
+    if (!std::isfinite(d))
+      continue;
+
+    CHECK(Rational::fromDouble(d).toDouble() == d);
+  }
+}
+
+// the parsed length, or -1 - offset of the error with value unchanged
+long parse(const char* text, Rational& value) {
+  auto last = text + std::strlen(text);
+  auto before = value;
+  auto [ptr, ec] = fromChars(text, last, value);
+  if (ec == std::errc{})
+    return ptr - text;
+
+  CHECK(ec == std::errc::invalid_argument && value == before);
+  return -1 - (ptr - text);
+}
+
+void testFromChars() {
+  Rational value{};
+  CHECK(parse("-3/6", value) == 4);
+  CHECK(value == Rational(BigInteger{-1}, BigInteger{2}));
+  CHECK(parse("1.25", value) == 4);
+  CHECK(value == Rational(BigInteger{5}, BigInteger{4}));
+  CHECK(parse("-0.5", value) == 4);
+  CHECK(value == Rational(BigInteger{-1}, BigInteger{2}));
+  CHECK(parse("+7", value) == 2 && value == 7);
+  CHECK(parse("0/5", value) == 3 && value == 0);
+  CHECK(parse("1.000", value) == 5 && value == 1);
+  CHECK(parse("12x", value) == 2 && value == 12);
+  CHECK(parse("123456789012345678901234567890/4", value) == 32);
+  CHECK(value == Rational(BigInteger{"61728394506172839450617283945"},
+                          BigInteger{2}));
+
+  // the error points at the offending character
+  value = 5;
+  CHECK(parse("", value) == -1);
+  CHECK(parse("abc", value) == -1);
+  CHECK(parse("-", value) == -2);
+  CHECK(parse("+-1", value) == -2);
+  CHECK(parse("1/", value) == -3);
+  CHECK(parse("1.", value) == -3);
+  CHECK(parse("1/0", value) == -3);
+  CHECK(parse("7/000", value) == -3);
+  CHECK(parse("1./2", value) == -3);
+  CHECK(value == 5);
+}
+
+void testTextRoundTrip() {
+  std::mt19937 gen{44};
+  std::stringstream stream{};
+  std::vector<Rational> values{};
+  for (int i = 0; i != 200; ++i) {
+    values.push_back(randomRational(gen, i % 2 ? 40 : 8));
+    stream << values.back() << (i % 7 ? " " : "\n");
+
+    Rational parsed{};
+    auto text = values.back().toString();
+    auto [ptr, ec] = fromChars(text.data(), text.data() + text.size(), parsed);
+    CHECK(ec == std::errc{} && ptr == text.data() + text.size());
+    CHECK(parsed == values.back());
+  }
+
+  for (auto&& item : values) {
+    Rational parsed{};
+    stream >> parsed;
+    CHECK(parsed == item);
+  }
+
+  std::istringstream malformed{"1/2 3/x"};
+  Rational parsed{};
+  malformed >> parsed;
+  CHECK_THROWS(malformed >> parsed);
+}
+
+constexpr std::array<RoundingMode, 6> kModes{
+    RoundingMode::HalfEven,     RoundingMode::HalfAwayFromZero,
+    RoundingMode::TowardZero,   RoundingMode::AwayFromZero,
+    RoundingMode::Floor,        RoundingMode::Ceiling};
+
+// num / denom printed with precision digits in the order of kModes
+struct DecimalCase {
+  int num;
+  int denom;
+  std::size_t precision;
+  std::array<const char*, 6> expected;
+};
+
+constexpr DecimalCase kDecimalCases[]{
+    {1, 8, 2, {"0.12", "0.13", "0.12", "0.13", "0.12", "0.13"}},
+    {-1, 8, 2, {"-0.12", "-0.13", "-0.12", "-0.13", "-0.13", "-0.12"}},
+    {5, 2, 0, {"2", "3", "2", "3", "2", "3"}},
+    {7, 2, 0, {"4", "4", "3", "4", "3", "4"}},
+    {-5, 2, 0, {"-2", "-3", "-2", "-3", "-3", "-2"}},
+    {2, 3, 3, {"0.667", "0.667", "0.666", "0.667", "0.666", "0.667"}},
+    {-2, 3, 3, {"-0.667", "-0.667", "-0.666", "-0.667", "-0.667", "-0.666"}},
+    {1, 3, 0, {"0", "0", "0", "1", "0", "1"}},
+    {-1, 3, 0, {"0", "0", "0", "-1", "-1", "0"}},
+    {3, 1, 2, {"3.00", "3.00", "3.00", "3.00", "3.00", "3.00"}},
+    {999, 1000, 2, {"1.00", "1.00", "0.99", "1.00", "0.99", "1.00"}},
+    {-1, 1000, 2, {"0.00", "0.00", "0.00", "-0.01", "-0.01", "0.00"}},
+};
+
+void testAsDecimal() {
+  for (auto&& item : kDecimalCases) {
+    Rational value{BigInteger{item.num}, BigInteger{item.denom}};
+    for (std::size_t i = 0; i != kModes.size(); ++i) {
+      CHECK(value.asDecimal(item.precision, kModes[i]) == item.expected[i]);
+    }
+  }
+
+  // the defaults truncate to an integer
+  CHECK(Rational(BigInteger{7}, BigInteger{2}).asDecimal() == "3");
+  CHECK(Rational(BigInteger{-7}, BigInteger{2}).asDecimal() == "-3");
+  CHECK(Rational{}.asDecimal(3) == "0.000");
+  CHECK(Rational(BigInteger{1}, BigInteger{7}).asDecimal(30) ==
+        "0.142857142857142857142857142857");
+  CHECK(Rational(BigInteger{"-123456789012345678901234567891"},
+                 BigInteger{10})
+            .asDecimal(0, RoundingMode::HalfEven) ==
+        "-12345678901234567890123456789");
+}
+
+// the order of the cross products, which compare must agree with
+int crossOrder(const Rational& lhs, const Rational& rhs) {
+  auto order = lhs.numerator() * rhs.denominator() <=>
+               rhs.numerator() * lhs.denominator();
+  return order < 0 ? -1 : (order > 0 ? 1 : 0);
+}
+
+void checkOrder(const Rational& lhs, const Rational& rhs, int expected) {
+  CHECK(crossOrder(lhs, rhs) == expected);
+  CHECK(lhs.compare(rhs) == expected && rhs.compare(lhs) == -expected);
+  CHECK((-lhs).compare(-rhs) == -expected);
+}
+
+void testCompare() {
+  BigInteger big{"1000000000000000000000000000000"};
+  Rational huge{big + 1, BigInteger{7}};
+  Rational tiny{BigInteger{1}, big};
+
+  // the signs decide, also against a zero and a word
+  checkOrder(Rational{BigInteger{-1}, big}, tiny, -1);
+  checkOrder(Rational{}, tiny, -1);
+  checkOrder(Rational{-1}, tiny, -1);
+  checkOrder(-huge, Rational{1}, -1);
+  checkOrder(Rational{big, big + 1}, Rational{big, big + 1}, 0);
+
+  // equal denominators or equal numerators
+  checkOrder(Rational{big + 3, big + 2}, Rational{big + 1, big + 2}, 1);
+  checkOrder(Rational{big + 3, big + 2}, Rational{big + 3, big + 4}, 1);
+
+  // scales two apart, and one apart where the scale does not decide
+  checkOrder(Rational{big * big, BigInteger{3}}, Rational{big * 100, 7}, 1);
+  checkOrder(Rational{big * 10, BigInteger{99}}, Rational{big - 1, 9}, -1);
+  checkOrder(Rational{big * 10 - 1, BigInteger{10}},
+             Rational{big + 1, BigInteger{1}}, -1);
+
+  // the integer parts differ, or they agree and the remainders decide
+  checkOrder(Rational{big * 3 + 1, big}, Rational{big * 2 + 5, big + 1}, 1);
+  checkOrder(Rational{big * 3 + 1, big}, Rational{big * 3 + 2, big + 1}, 1);
+  checkOrder(Rational{big * 3 + 2, big}, Rational{big * 3 + 7, big + 1},
+             -1);
+  checkOrder(Rational{big - 1, big}, Rational{big, big + 1}, -1);
+
+  std::mt19937 gen{38};
+  for (int i = 0; i != 300; ++i) {
+    auto lhs = randomRational(gen, 1 + i % 40);
+    auto rhs = i % 3 ? randomRational(gen, 1 + i % 40) : lhs + tiny;
+    checkOrder(lhs, rhs, crossOrder(lhs, rhs));
+  }
+}
+
+// the word path against a reference built from the big parts
+void checkInline(const Rational& value, const BigInteger& num,
+                 const BigInteger& denom) {
+  Rational expected{num, denom};
+  CHECK(value == expected && value.compare(expected) == 0);
+  CHECK(value.toString() == expected.toString());
+  CHECK(value.numerator() == expected.numerator() &&
+        value.denominator() == expected.denominator());
+}
+
+void testInlineLimits() {
+  BigInteger min{std::numeric_limits<std::int64_t>::min()};
+  BigInteger max{std::numeric_limits<std::int64_t>::max()};
+  Rational lowest{min, BigInteger{1}};
+  checkInline(-lowest, -min, 1);
+  checkInline(-(-lowest), min, 1);
+  checkInline(lowest + Rational{1} - Rational{1}, min, 1);
+  checkInline(lowest / Rational{-1}, -min, 1);
+  checkInline(Rational{BigInteger{1}, min}, -1, -min);
+  checkInline(Rational{max, BigInteger{1}} + Rational{1}, max + 1, 1);
+  checkInline(Rational{max} * Rational{max}, max * max, 1);
+
+  // 18 digits are kept inline, sums may grow past them in the word
+  BigInteger edge{"999999999999999999"};
+  Rational word{edge};
+  auto sum = word + word;
+  checkInline(sum, edge * 2, 1);
+  checkInline(sum + sum + sum + sum + sum, edge * 10, 1);
+  checkInline(-sum - sum - sum - sum - sum, edge * -10, 1);
+  checkInline(sum - word - word, 0, 1);
+
+  // products past the word fall back to the big path and come back
+  auto square = word * word;
+  checkInline(square, edge * edge, 1);
+  checkInline(square / word, edge, 1);
+  checkInline(Rational{1} / square * word, 1, edge);
+  BigInteger root{3037000500};
+  checkInline(Rational{root} * Rational{-root}, root * -root, 1);
+  checkInline(Rational{BigInteger{1}, edge} + Rational{BigInteger{1}, edge - 1},
+              edge * 2 - 1, edge * (edge - 1));
+  checkInline(Rational{BigInteger{1}, edge} - Rational{BigInteger{1}, edge - 1},
+              -1, edge * (edge - 1));
+
+  std::mt19937 gen{39};
+  for (int i = 0; i != 300; ++i) {
+    auto a = test::randomNumber(gen, 10 + i % 9);
+    auto b = test::randomNumber(gen, 10 + i % 9);
+    auto c = test::randomNumber(gen, 10 + i % 9);
+    auto d = test::randomNumber(gen, 10 + i % 9);
+    b = b ? b : 1;
+    d = d ? d : 1;
+    Rational lhs{a, b};
+    Rational rhs{c, d};
+    checkInline(lhs + rhs, a * d + c * b, b * d);
+    checkInline(lhs - rhs, a * d - c * b, b * d);
+    checkInline(lhs * rhs, a * c, b * d);
+    if (c)
+      checkInline(lhs / rhs, a * d, b * c);
+  }
+}
+
+// a product is reduced with a positive denominator
+void checkProduct(const Rational& value, const BigInteger& num,
+                  const BigInteger& denom) {
+  CHECK(value.numerator() == num && value.denominator() == denom);
+  CHECK(gcd(num, denom) == 1 && denom.sign() > 0);
+}
+
+void testCrossCancellation() {
+  BigInteger big{"1000000000000000000000000000000"};
+  Rational large{big * 3, big + 1};
+  Rational word{BigInteger{-6}, BigInteger{35}};
+
+  // a zero operand gives zero over one on both paths
+  for (auto&& value : {large, -large, word}) {
+    checkProduct(value * Rational{}, 0, 1);
+    checkProduct(Rational{} * value, 0, 1);
+    checkProduct(Rational{} / value, 0, 1);
+    checkProduct(value - value, 0, 1);
+    CHECK_THROWS(value / Rational{});
+  }
+
+  // the signs survive the cancelled factors
+  checkProduct(large * -large, big * big * -9, (big + 1) * (big + 1));
+  checkProduct(-large * -large, big * big * 9, (big + 1) * (big + 1));
+  checkProduct(large / -large, -1, 1);
+  checkProduct(-large / large, -1, 1);
+  checkProduct(large * Rational{big + 1, big * -3}, -1, 1);
+  checkProduct(Rational{big + 1, big * -6} * large, -1, 2);
+  checkProduct(large * Rational{BigInteger{-2}, big * 9}, -2, (big + 1) * 3);
+  checkProduct(word * Rational{BigInteger{-7}, BigInteger{12}}, 1, 10);
+  checkProduct(word / Rational{BigInteger{-12}, BigInteger{7}}, 1, 10);
+  checkProduct(word * Rational{BigInteger{35}, big * -2}, 3, big);
+  checkProduct(word / large, -(big + 1), big / 2 * 35);
+
+  std::mt19937 gen{37};
+  for (int i = 0; i != 300; ++i) {
+    auto lhs = randomRational(gen, 1 + i % 30);
+    auto rhs = randomRational(gen, 1 + i % 30);
+    Rational expected{lhs.numerator() * rhs.numerator(),
+                      lhs.denominator() * rhs.denominator()};
+    auto product = lhs * rhs;
+    checkProduct(product, expected.numerator(), expected.denominator());
+    if (rhs != 0)
+      CHECK(product / rhs == lhs && -product / -rhs == lhs);
+  }
+}
+
+} // namespace
+
+int main() {
+  testContinuedFraction();
+  testLimitDenominator();
+  testToDouble();
+  testFromDouble();
+  testFromChars();
+  testTextRoundTrip();
+  testAsDecimal();
+  testCompare();
+  testInlineLimits();
+  testCrossCancellation();
+  return test::result();
+}
@@ -0,0 +1,153 @@
+#include "check.h"
+#include "random.h"
+
+#include "long_arithmetic/rationalMatrix.h"
+
+#include <cstddef>
+#include <random>
+#include <vector>
+
+
+namespace {
+
+RationalMatrix randomMatrix(std::mt19937& gen, std::size_t rows,
+                            std::size_t cols) {
+  RationalMatrix res{rows, cols};
+  for (std::size_t i = 0; i != rows; ++i) {
+    for (std::size_t j = 0; j != cols; ++j) {
+      auto denom = test::randomNumber(gen, 2);
+      res(i, j) = Rational{test::randomNumber(gen, 3), denom ? denom : 1};
+    }
+  }
+
+  return res;
+}
+
+RationalMatrix hilbert(std::size_t size) {
+  RationalMatrix res{size, size};
+  for (std::size_t i = 0; i != size; ++i) {
+    for (std::size_t j = 0; j != size; ++j) {
+      res(i, j) = Rational{BigInteger{1},
+                           BigInteger{static_cast<long long>(i + j + 1)}};
+    }
+  }
+
+  return res;
+}
+
+// Laplace expansion along the first row as the reference
+Rational laplace(const RationalMatrix& matrix) {
+  auto size = matrix.rows();
+  if (size == 1)
+    return matrix(0, 0);
+
+  Rational res{};
+  for (std::size_t col = 0; col != size; ++col) {
+    RationalMatrix minor{size - 1, size - 1};
+    for (std::size_t i = 1; i != size; ++i) {
+      for (std::size_t j = 0, k = 0; j != size; ++j) {
+        if (j != col)
+          minor(i - 1, k++) = matrix(i, j);
+      }
+    }
+
+    auto term = matrix(0, col) * laplace(minor);
+    col % 2 ? res -= term : res += term;
+  }
+
+  return res;
+}
+
+void testDeterminant() {
+  CHECK(RationalMatrix::identity(4).determinant() == 1);
+  CHECK(hilbert(4).determinant() ==
+        Rational(BigInteger{1}, BigInteger{6048000}));
+  CHECK(hilbert(5).determinant() ==
+        Rational(BigInteger{1}, BigInteger{266716800000}));
+
+  // a zero pivot needs a row swap
+  RationalMatrix swap{{0, 1}, {1, 0}};
+  CHECK(swap.determinant() == -1);
+  RationalMatrix singular{{1, 2, 3}, {2, 4, 6}, {1, 0, 1}};
+  CHECK(singular.determinant() == 0);
+  CHECK_THROWS(RationalMatrix(2, 3).determinant());
+
+  std::mt19937 gen{42};
+  for (std::size_t size = 1; size != 6; ++size) {
+    for (int i = 0; i != 5; ++i) {
+      auto matrix = randomMatrix(gen, size, size);
+      CHECK(matrix.determinant() == laplace(matrix));
+    }
+  }
+}
+
+void testRank() {
+  CHECK(RationalMatrix(3, 4).rank() == 0);
+  CHECK(RationalMatrix::identity(5).rank() == 5);
+  CHECK(hilbert(6).rank() == 6);
+
+  // the last rows are combinations of the first ones
+  std::mt19937 gen{43};
+  for (std::size_t rank = 1; rank != 4; ++rank) {
+    auto matrix = randomMatrix(gen, 5, 4);
+    for (std::size_t i = rank; i != 5; ++i) {
+      auto factor = Rational{static_cast<int>(i)};
+      for (std::size_t j = 0; j != 4; ++j) {
+        matrix(i, j) = matrix(0, j) * factor + matrix(rank - 1, j);
+      }
+    }
+
+    CHECK(matrix.rank() == rank);
+  }
+}
+
+void testSolve() {
+  std::mt19937 gen{44};
+  for (std::size_t size = 1; size != 7; ++size) {
+    auto matrix = randomMatrix(gen, size, size);
+    if (matrix.determinant() == 0)
+      continue;
+
+    std::vector<Rational> rhs(size);
+    for (auto&& item : rhs) {
+      item = Rational{test::randomNumber(gen, 4)};
+    }
+
+    auto solution = matrix.solve(rhs);
+    CHECK(solution.size() == size);
+    for (std::size_t i = 0; i != size; ++i) {
+      Rational row{};
+      for (std::size_t j = 0; j != size; ++j) {
+        row += matrix(i, j) * solution[j];
+      }
+
+      CHECK(row == rhs[i]);
+    }
+  }
+
+  std::vector<Rational> rhs{1, 2, 3};
+  RationalMatrix singular{{1, 2, 3}, {2, 4, 6}, {1, 0, 1}};
+  CHECK_THROWS(singular.solve(rhs));
+  CHECK_THROWS(RationalMatrix::identity(2).solve(rhs));
+  CHECK_THROWS(RationalMatrix(3, 2).solve(rhs));
+}
+
+void testConstruction() {
+  RationalMatrix matrix{{1, 2, 3}, {4, 5, 6}};
+  CHECK(matrix.rows() == 2 && matrix.cols() == 3);
+  CHECK(matrix(1, 2) == 6);
+  matrix(0, 0) = Rational{BigInteger{1}, BigInteger{2}};
+  CHECK(matrix != RationalMatrix({{1, 2, 3}, {4, 5, 6}}));
+  CHECK(RationalMatrix::identity(2) == RationalMatrix({{1, 0}, {0, 1}}));
+  CHECK_THROWS(RationalMatrix({{1, 2}, {3}}));
+}
+
+} // namespace
+
+int main() {
+  testDeterminant();
+  testRank();
+  testSolve();
+  testConstruction();
+  return test::result();
+}
@@ -0,0 +1,246 @@
+#include "check.h"
+#include "random.h"
+
+#include "long_arithmetic/bigIntegerView.h"
+#include "long_arithmetic/serialization.h"
+
+#include <cstddef>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+namespace {
+
+std::vector<BigInteger> randomValues(std::size_t count) {
+  std::mt19937 gen{29};
+  std::vector<BigInteger> res{0, 1, -1, 10, -99};
+  for (std::size_t i = 0; i != count; ++i) {
+    res.push_back(test::randomNumber(gen, 1 + i % 60));
+  }
+
+  return res;
+}
+
+// the sign byte, the 8 byte count and the packed digits
+std::string encode(char sign, std::size_t count, const std::string& digits) {
+  std::string res(1, sign);
+  for (std::size_t i = 0; i != 8; ++i) {
+    res.push_back(static_cast<char>((count >> (8 * i)) & 0xff));
+  }
+
+  return res + digits;
+}
+
+void testLayout() {
+  std::ostringstream out{};
+  {
+    BinaryWriter writer{out};
+    writer.write(BigInteger{-12345});
+  }
+
+  CHECK(out.str() == encode(1, 5, "\x45\x23\x01"));
+}
+
+void testBinaryRoundTrip() {
+  auto values = randomValues(300);
+  std::vector<Rational> rationals{};
+  for (std::size_t i = 0; i + 1 < values.size(); i += 2) {
+    rationals.push_back(values[i + 1] ? Rational{values[i], values[i + 1]}
+                                      : Rational{values[i]});
+  }
+
+  // tiny buffers make every value cross a refill
+  for (std::size_t buffer_size : {1, 3, 4096}) {
+    std::stringstream stream{};
+    {
+      BinaryWriter writer{stream, buffer_size};
+      for (auto&& value : values) {
+        writer.write(value);
+      }
+
+      for (auto&& value : rationals) {
+        writer.write(value);
+      }
+    }
+
+    BinaryReader reader{stream, buffer_size};
+    BigInteger number{};
+    for (auto&& value : values) {
+      CHECK(reader.read(number) && number == value);
+    }
+
+    Rational fraction{};
+    for (auto&& value : rationals) {
+      CHECK(reader.read(fraction) && fraction == value);
+    }
+
+    CHECK(!reader.read(number));
+  }
+}
+
+// a failed read leaves the target as it was
+void checkRejected(const std::string& bytes) {
+  std::istringstream in{bytes};
+  BinaryReader reader{in};
+  BigInteger value{777};
+  CHECK_THROWS(reader.read(value));
+  CHECK(value == 777);
+}
+
+void testMalformed() {
+  checkRejected(encode(0, 3, "\x21"));
+  checkRejected(encode(0, 2, "\x2a"));
+  checkRejected(encode(0, 2, "\x01"));
+  checkRejected(encode(1, 0, ""));
+  checkRejected(encode(2, 1, "\x01"));
+  checkRejected(encode(0, 1, "\x71"));
+  checkRejected(std::string("\x00\x01", 2));
+
+  std::istringstream in{encode(0, 1, "\x01") + encode(0, 0, "")};
+  BinaryReader reader{in};
+  Rational value{5};
+  CHECK_THROWS(reader.read(value));
+  CHECK(value == 5);
+}
+
+void testMapped() {
+  auto path = std::filesystem::temp_directory_path() /
+              ("long_arithmetic_mapped_" +
+               std::to_string(std::random_device{}()));
+  auto values = randomValues(200);
+  {
+    std::ofstream out{path, std::ios::binary};
+    BinaryWriter writer{out};
+    for (auto&& value : values) {
+      writer.write(value);
+    }
+  }
+
+  {
+    MappedBigIntegers mapped{path.string()};
+    std::size_t count{0};
+    for (auto&& view : mapped) {
+      CHECK(count < values.size() && view == values[count] &&
+            view.toString() == values[count].toString() &&
+            view.hash() == values[count].hash());
+      ++count;
+    }
+
+    CHECK(count == values.size());
+  }
+
+  std::filesystem::remove(path);
+}
+
+// a corrupt record throws when the iteration reaches it
+void checkMappedRejected(const std::string& bytes) {
+  auto path = std::filesystem::temp_directory_path() /
+              ("long_arithmetic_corrupt_" +
+               std::to_string(std::random_device{}()));
+  {
+    std::ofstream out{path, std::ios::binary};
+    out << encode(0, 2, "\x21") << bytes;
+  }
+
+  {
+    MappedBigIntegers mapped{path.string()};
+    auto it = mapped.begin();
+    CHECK(*it == 21);
+    CHECK_THROWS(++it);
+  }
+
+  std::filesystem::remove(path);
+}
+
+void testMappedMalformed() {
+  checkMappedRejected(encode(0, 2, "\x2a"));
+  checkMappedRejected(encode(0, 2, "\xa2"));
+  checkMappedRejected(encode(0, 3, "\x21\x1f"));
+  checkMappedRejected(encode(0, 3, "\x21\x71"));
+  checkMappedRejected(encode(0, 2, "\x01"));
+  checkMappedRejected(encode(1, 0, ""));
+  checkMappedRejected(encode(2, 1, "\x01"));
+  checkMappedRejected(encode(0, 4, "\x21"));
+}
+
+// the message of the error the reader stops with, empty if it reads all
+std::string readAll(const std::string& text, std::size_t buffer_size,
+                    std::vector<Rational>& values) {
+  std::istringstream in{text};
+  TextReader reader{in, buffer_size};
+  values.clear();
+  try {
+    Rational value{};
+    while (reader.read(value)) {
+      values.push_back(value);
+    }
+  } catch (const std::exception& error) {
+    return error.what();
+  }
+
+  return {};
+}
+
+void testTextReader() {
+  std::mt19937 gen{45};
+  std::string text{"  \n"};
+  std::vector<Rational> expected{};
+  for (int i = 0; i != 300; ++i) {
+    auto denom = test::randomNumber(gen, 30);
+    expected.emplace_back(test::randomNumber(gen, 60), denom ? denom : 1);
+    text += expected.back().toString() + (i % 5 ? " \t" : "\r\n");
+  }
+
+  text += "0.125 -2.5\n\n";
+  expected.emplace_back(BigInteger{1}, BigInteger{8});
+  expected.emplace_back(BigInteger{-5}, BigInteger{2});
+
+  // tokens split by the buffer end, and buffers smaller than a token
+  for (std::size_t buffer_size : {1, 2, 7, 64, 1 << 16}) {
+    std::vector<Rational> values{};
+    CHECK(readAll(text, buffer_size, values).empty());
+    CHECK(values == expected);
+  }
+
+  std::vector<Rational> values{};
+  CHECK(readAll("", 16, values).empty() && values.empty());
+
+  // the last token ends with the input rather than with a space
+  for (std::size_t buffer_size : {1, 2, 3, 5, 1 << 16}) {
+    CHECK(readAll("1/2 3/4", buffer_size, values).empty());
+    CHECK((values == std::vector<Rational>{{1, 2}, {3, 4}}));
+    CHECK(readAll("5 -7/3", buffer_size, values).empty());
+    CHECK((values == std::vector<Rational>{{5}, {-7, 3}}));
+    CHECK(readAll("\n  -12", buffer_size, values).empty());
+    CHECK((values == std::vector<Rational>{{-12}}));
+  }
+
+  CHECK(readAll(" \n\t ", 16, values).empty() && values.empty());
+
+  for (std::size_t buffer_size : {1, 3, 1 << 16}) {
+    CHECK(readAll("1/2 3\n4/5\n  6/7 8/0 9", buffer_size, values) ==
+          "malformed rational at line 3, column 9");
+    CHECK(values.size() == 4);
+    CHECK(readAll("1 2\n\n-x", buffer_size, values) ==
+          "malformed rational at line 3, column 2");
+    CHECK(readAll("12/3abc", buffer_size, values) ==
+          "malformed rational at line 1, column 5");
+  }
+}
+
+} // namespace
+
+int main() {
+  testLayout();
+  testBinaryRoundTrip();
+  testMalformed();
+  testMapped();
+  testMappedMalformed();
+  testTextReader();
+  return test::result();
+}
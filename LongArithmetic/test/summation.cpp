@@ -0,0 +1,79 @@
+#include "check.h"
+#include "random.h"
+
+#include "long_arithmetic/summation.h"
+
+#include <cstddef>
+#include <random>
+#include <vector>
+
+
+namespace {
+
+// sizes around the chunk boundaries with several thread counts, so the
+// merge tree gets odd rounds and idle threads
+constexpr std::size_t kSizes[]{0, 1, 4095, 4096, 4097, 4 * 4096 + 1};
+constexpr std::size_t kThreads[]{0, 1, 2, 3, 8};
+
+void testBigInteger() {
+  std::mt19937 gen{43};
+  for (auto size : kSizes) {
+    std::vector<BigInteger> lhs{};
+    std::vector<BigInteger> rhs{};
+    BigInteger expected_sum{};
+    BigInteger expected_dot{};
+    for (std::size_t i = 0; i != size; ++i) {
+      lhs.push_back(test::randomNumber(gen, 30));
+      rhs.push_back(test::randomNumber(gen, 5));
+      expected_sum += lhs.back();
+      expected_dot += lhs.back() * rhs.back();
+    }
+
+    for (auto threads : kThreads) {
+      CHECK(sum(lhs, threads) == expected_sum);
+      CHECK(dot(lhs, rhs, threads) == expected_dot);
+    }
+  }
+}
+
+void testRational() {
+  std::mt19937 gen{44};
+  // the least common multiple of the denominators fits a word
+  std::uniform_int_distribution<int> denom{1, 12};
+  for (auto size : kSizes) {
+    std::vector<Rational> lhs{};
+    std::vector<Rational> rhs{};
+    Rational expected_sum{};
+    Rational expected_dot{};
+    for (std::size_t i = 0; i != size; ++i) {
+      lhs.emplace_back(test::randomNumber(gen, 4), BigInteger{denom(gen)});
+      rhs.emplace_back(test::randomNumber(gen, 2), BigInteger{denom(gen)});
+      expected_sum += lhs.back();
+      expected_dot += lhs.back() * rhs.back();
+    }
+
+    for (auto threads : {0, 1, 3}) {
+      CHECK(sum(lhs, threads) == expected_sum);
+      CHECK(dot(lhs, rhs, threads) == expected_dot);
+    }
+  }
+}
+
+void testSizes() {
+  std::vector<BigInteger> three(3);
+  std::vector<BigInteger> two(2);
+  CHECK_THROWS(dot(three, two));
+
+  std::vector<Rational> rational_three(3);
+  std::vector<Rational> rational_two(2);
+  CHECK_THROWS(dot(rational_three, rational_two, 2));
+}
+
+} // namespace
+
+int main() {
+  testBigInteger();
+  testRational();
+  testSizes();
+  return test::result();
+}
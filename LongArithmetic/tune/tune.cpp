@@ -0,0 +1,149 @@
+#include "long_arithmetic/bigInteger.h"
+#include "long_arithmetic/tuning.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+
+namespace {
+
+// the search range of the Karatsuba threshold in limbs
+constexpr std::size_t kMinSize{8};
+constexpr std::size_t kMaxSize{1024};
+// Karatsuba has to win at this many sizes in a row, so a single noisy
+// measurement does not decide the threshold
+constexpr std::size_t kConfirmations{3};
+constexpr std::size_t kRepetitions{5};
+constexpr std::chrono::nanoseconds kMinDuration{std::chrono::milliseconds{10}};
+
+std::string randomDigits(std::size_t count, std::uint32_t seed) {
+  std::mt19937 gen{seed};
+  std::uniform_int_distribution<int> digit{0, 9};
+  std::string res(count, '0');
+  for (auto&& item : res) {
+    item = static_cast<char>('0' + digit(gen));
+  }
+
+  res.front() = static_cast<char>('1' + digit(gen) % 9);
+  return res;
+}
+
+// nanoseconds per product, the best of several runs of at least
+// kMinDuration each
+double measure(const BigInteger& lhs, const BigInteger& rhs) {
+  using Clock = std::chrono::steady_clock;
+  double best{0};
+  for (std::size_t run = 0; run != kRepetitions; ++run) {
+    std::size_t count{0};
+    auto start = Clock::now();
+    auto elapsed = Clock::duration{};
+    do {
+      auto product = lhs * rhs;
+      if (!product)
+        throw std::runtime_error("zero product of non-zero numbers");
+
+      ++count;
+      elapsed = Clock::now() - start;
+    } while (elapsed < kMinDuration);
+
+    auto time = static_cast<double>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        elapsed)
+                        .count()) /
+                static_cast<double>(count);
+    if (run == 0 || time < best)
+      best = time;
+  }
+
+  return best;
+}
+
+// compares plain schoolbook multiplication of n-limb operands with one
+// Karatsuba step on top of it: the halves stay below a threshold of n
+std::size_t tuneKaratsuba(std::ostream& log) {
+  std::size_t wins{0};
+  std::size_t first_win{kMaxSize};
+  for (auto size = kMinSize; size <= kMaxSize;
+       size = std::max(size + 1, size * 11 / 10)) {
+    BigInteger lhs{randomDigits(size, 1)};
+    BigInteger rhs{randomDigits(size, 2)};
+
+    setThresholds({size + 1});
+    auto schoolbook = measure(lhs, rhs);
+    setThresholds({size});
+    auto karatsuba = measure(lhs, rhs);
+
+    log << "karatsuba " << size << " limbs: schoolbook " << schoolbook
+        << " ns, karatsuba " << karatsuba << " ns\n";
+    if (karatsuba < schoolbook) {
+      if (!wins++)
+        first_win = size;
+
+      if (wins == kConfirmations)
+        return first_win;
+    } else {
+      wins = 0;
+      first_win = kMaxSize;
+    }
+  }
+
+  return first_win;
+}
+
+void writeHeader(std::ostream& out, const Thresholds& value) {
+  out << "// generated by long_arithmetic_tune for the host it ran on\n"
+      << "#pragma once\n"
+      << "#ifndef LONG_ARITHMETIC_THRESHOLDS_H_\n"
+      << "#define LONG_ARITHMETIC_THRESHOLDS_H_\n"
+      << "\n"
+      << "#include <cstddef>\n"
+      << "\n"
+      << "\n"
+      << "namespace details {\n"
+      << "\n"
+      << "constexpr std::size_t kKaratsubaThreshold{" << value.karatsuba
+      << "};\n"
+      << "\n"
+      << "} // namespace details\n"
+      << "\n"
+      << "#endif // LONG_ARITHMETIC_THRESHOLDS_H_\n";
+}
+
+} // namespace
+
+// usage: long_arithmetic_tune [header], the header goes to the standard
+// output when no path is given and the measurements to the standard error
+int main(int argc, char* argv[]) {
+  try {
+    if (argc > 2) {
+      std::cerr << "usage: " << argv[0] << " [header]\n";
+      return 1;
+    }
+
+    Thresholds tuned{tuneKaratsuba(std::cerr)};
+    std::cerr << "karatsuba threshold: " << tuned.karatsuba << " limbs\n";
+
+    if (argc == 1) {
+      writeHeader(std::cout, tuned);
+      return 0;
+    }
+
+    std::ofstream out{argv[1]};
+    writeHeader(out, tuned);
+    if (!out) {
+      std::cerr << "cannot write " << argv[1] << "\n";
+      return 1;
+    }
+  } catch (const std::exception& error) {
+    std::cerr << error.what() << "\n";
+    return 1;
+  }
+}